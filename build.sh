@@ -8,4 +8,14 @@ fi
 clang -pedantic -D_GNU_SOURCE -Wall -Wextra -Werror -std=c99 -g -I./thirdparty -I./code ./thirdparty/stb_truetype.c \
     ./code/main.c ./code/tgui.c ./code/tgui_memory.c ./code/tgui_gfx.c ./code/tgui_os.c \
     ./code/tgui_painter.c ./code/tgui_geometry.c ./code/tgui_docker.c ./code/tgui_serializer.c \
-    -o ./build/app -lm -lX11 -lGL -lXcursor -Wno-implicit-fallthrough
+    -o ./build/app -lm -lpthread -lX11 -lGL -lXcursor -Wno-implicit-fallthrough
+
+clang -pedantic -D_GNU_SOURCE -Wall -Wextra -Werror -std=c99 -g -I./thirdparty -I./code ./thirdparty/stb_truetype.c \
+    ./code/main_headless.c ./code/tgui.c ./code/tgui_memory.c ./code/tgui_gfx.c ./code/tgui_gfx_software.c ./code/tgui_os.c \
+    ./code/tgui_painter.c ./code/tgui_geometry.c ./code/tgui_docker.c ./code/tgui_serializer.c \
+    -o ./build/headless -lm -lpthread -Wno-implicit-fallthrough
+
+clang -pedantic -D_GNU_SOURCE -Wall -Wextra -Werror -std=c99 -g -DTGUI_PACKED_VERTEX -I./thirdparty -I./code ./thirdparty/stb_truetype.c \
+    ./code/main_headless.c ./code/tgui.c ./code/tgui_memory.c ./code/tgui_gfx.c ./code/tgui_gfx_software.c ./code/tgui_os.c \
+    ./code/tgui_painter.c ./code/tgui_geometry.c ./code/tgui_docker.c ./code/tgui_serializer.c \
+    -o ./build/headless_packed -lm -lpthread -Wno-implicit-fallthrough
@@ -243,7 +243,7 @@ void os_window_poll_events(struct OsWindow *window, TGuiInput *input) {
         } break;
 
         case Expose: {
-
+            tgui_invalidate_frame();
         } break;
         
         case KeymapNotify: {
@@ -425,42 +425,299 @@ void tgui_opengl_destroy_program(void *program) {
     glDeleteProgram((tgui_u64)program);
 }
 
-void *tgui_opengl_create_texture(tgui_u32 *data, tgui_u32 width, tgui_u32 height) {
+/* NOTE: Every texture is an array so the same programs draw the atlas pages and the other textures */
+void *tgui_opengl_create_texture(tgui_u32 *data, tgui_u32 width, tgui_u32 height, tgui_u32 pages) {
+    
+    tgui_u32 texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA, width, height, pages, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+    
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    return (void *)(tgui_u64)texture;
+}
+
+void tgui_opengl_update_texture(void *texture, tgui_u32 page, tgui_u32 *data, tgui_u32 stride, tgui_u32 x, tgui_u32 y, tgui_u32 w, tgui_u32 h) {
+    
+    glBindTexture(GL_TEXTURE_2D_ARRAY, (tgui_u32)(tgui_u64)texture);
+    
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, stride);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, x, y, page, w, h, 1, GL_RGBA, GL_UNSIGNED_BYTE, data);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+void *tgui_opengl_create_texture_r8(tgui_u8 *data, tgui_u32 width, tgui_u32 height) {
     
     tgui_u32 texture;
     glGenTextures(1, &texture);
-    glBindTexture(GL_TEXTURE_2D, texture);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+    /* NOTE: Sample the coverage as (1, 1, 1, r) so the quad shader works without changes */
+    GLint swizzle[4] = { GL_ONE, GL_ONE, GL_ONE, GL_RED };
+    glTexParameteriv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+    
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_R8, width, height, 1, 0, GL_RED, GL_UNSIGNED_BYTE, data);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
     
     glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
 
     return (void *)(tgui_u64)texture;
 }
 
+void tgui_opengl_update_texture_r8(void *texture, tgui_u8 *data, tgui_u32 stride, tgui_u32 x, tgui_u32 y, tgui_u32 w, tgui_u32 h) {
+    
+    glBindTexture(GL_TEXTURE_2D_ARRAY, (tgui_u32)(tgui_u64)texture);
+    
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, stride);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, x, y, 0, w, h, 1, GL_RED, GL_UNSIGNED_BYTE, data);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
 void tgui_opengl_destroy_texture(void *texture) {
     tgui_u32 id = (tgui_u64)texture;
     glDeleteTextures(1, &id);
 }
 
+/* NOTE: Needed to flip the clip rectangles, the scissor origin is the bottom left corner */
+static tgui_u32 viewport_height;
+
 void tgui_opengl_set_program_width_and_height(void *program, tgui_u32 width, tgui_u32 height) {
+    viewport_height = height;
     tgui_u32 id = (tgui_u64)program;
     glUseProgram(id);
     glUniform1i(glGetUniformLocation(id, "res_x"), width);
     glUniform1i(glGetUniformLocation(id, "res_y"), height);
 }
 
+void tgui_opengl_set_clip(TGuiRectangle clip) {
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(clip.min_x, (tgui_s32)viewport_height - (clip.max_y + 1), tgui_rect_width(clip), tgui_rect_height(clip));
+}
+
 tgui_u32 vao, vbo, ebo, rbo, fbo;
+/* NOTE: The quad indices of the render state uploaded to ebo */
+void *ebo_indices;
+tgui_u32 instanced_vao, instanced_vbo;
+tgui_u32 tri_vao, tri_vbo;
 void *custom_program;
 void *custom_texture;
+
+typedef struct TriangleVertex {
+    float x, y;
+    float u, v;
+    float r, g, b;
+} TriangleVertex;
 #define MAX_QUAD_PER_BATCH 1024
 
+/* NOTE: Streaming mode (ARB_buffer_storage). One buffer is persistently mapped and split in
+   TGUI_OPENGL_RING_FRAMES segments, the segment of a frame is guarded by a fence so the CPU
+   only writes into memory the GPU has finished reading, and no glBufferSubData is needed */
+
+#define TGUI_OPENGL_RING_FRAMES 3
+#define TGUI_OPENGL_RING_FRAME_SIZE (MB(2) - (MB(2) % sizeof(TGuiVertex)))
+
+typedef struct TGuiOpenGLRing {
+    
+    tgui_b32 enable;
+
+    tgui_u32 vao;
+    tgui_u32 instanced_vao;
+    tgui_u32 buffer;
+    tgui_u8 *memory;
+
+    tgui_u32 frame_index;
+    tgui_u64 frame_used;
+    GLsync fences[TGUI_OPENGL_RING_FRAMES];
+
+} TGuiOpenGLRing;
+
+TGuiOpenGLRing ring;
+
+static tgui_b32 os_gl_has_extension(char *name) {
+    GLint extensions_count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extensions_count);
+    for(GLint i = 0; i < extensions_count; ++i) {
+        const char *extension = (const char *)glGetStringi(GL_EXTENSIONS, i);
+        if(extension && strcmp(extension, name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* NOTE: Both vertex formats reach the shaders as vec2 position, vec2 uvs, vec3 color and the
+   page of the texture array as a float */
+static void tgui_opengl_setup_vertex_attributes(void) {
+
+#ifdef TGUI_PACKED_VERTEX
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_SHORT, GL_FALSE, sizeof(TGuiVertex), TGUI_OFFSET_OF(TGuiVertex, x)); 
+
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(TGuiVertex), TGUI_OFFSET_OF(TGuiVertex, u)); 
+
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, GL_BGRA, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(TGuiVertex), TGUI_OFFSET_OF(TGuiVertex, color)); 
+
+    /* NOTE: The page is the alpha byte of the color */
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 1, GL_UNSIGNED_BYTE, GL_FALSE, sizeof(TGuiVertex), (void *)((tgui_u64)TGUI_OFFSET_OF(TGuiVertex, color) + 3)); 
+#else
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(TGuiVertex), TGUI_OFFSET_OF(TGuiVertex, x)); 
+
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(TGuiVertex), TGUI_OFFSET_OF(TGuiVertex, u)); 
+
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(TGuiVertex), TGUI_OFFSET_OF(TGuiVertex, r)); 
+
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(TGuiVertex), TGUI_OFFSET_OF(TGuiVertex, page)); 
+#endif
+}
+
+/* NOTE: One TGuiQuadInstance per instance, the vertex shader expands the quad corners */
+static void tgui_opengl_setup_instance_attributes(tgui_u64 offset) {
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 4, GL_SHORT, GL_FALSE, sizeof(TGuiQuadInstance), (void *)(offset + (tgui_u64)TGUI_OFFSET_OF(TGuiQuadInstance, min_x))); 
+    glVertexAttribDivisor(0, 1);
+
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(TGuiQuadInstance), (void *)(offset + (tgui_u64)TGUI_OFFSET_OF(TGuiQuadInstance, min_u))); 
+    glVertexAttribDivisor(1, 1);
+
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, GL_BGRA, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(TGuiQuadInstance), (void *)(offset + (tgui_u64)TGUI_OFFSET_OF(TGuiQuadInstance, color))); 
+    glVertexAttribDivisor(2, 1);
+
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 1, GL_UNSIGNED_BYTE, GL_FALSE, sizeof(TGuiQuadInstance), (void *)(offset + (tgui_u64)TGUI_OFFSET_OF(TGuiQuadInstance, color) + 3)); 
+    glVertexAttribDivisor(3, 1);
+}
+
+static void tgui_opengl_wait_fence(GLsync fence) {
+    GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+    while(result == GL_TIMEOUT_EXPIRED) {
+        result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+    }
+    ASSERT(result != GL_WAIT_FAILED);
+    glDeleteSync(fence);
+}
+
+static void tgui_opengl_ring_initialize(void) {
+
+    ring.enable = glBufferStorage && glMapBufferRange && glFenceSync && os_gl_has_extension("GL_ARB_buffer_storage");
+    if(!ring.enable) {
+        printf("ARB_buffer_storage not supported, streaming mode disabled\n");
+        return;
+    }
+
+    tgui_u64 ring_size = TGUI_OPENGL_RING_FRAMES * TGUI_OPENGL_RING_FRAME_SIZE;
+    GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    glGenVertexArrays(1, &ring.vao);
+    glBindVertexArray(ring.vao);
+
+    glGenBuffers(1, &ring.buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, ring.buffer);
+    glBufferStorage(GL_ARRAY_BUFFER, ring_size, 0, flags);
+    ring.memory = (tgui_u8 *)glMapBufferRange(GL_ARRAY_BUFFER, 0, ring_size, flags);
+    ASSERT(ring.memory);
+
+    tgui_opengl_setup_vertex_attributes();
+
+    /* NOTE: Only the vertices are streamed, the quad indices are in the static index buffer */
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+
+    /* NOTE: The instance attributes pointers are set in every draw with the offset of the instances */
+    glGenVertexArrays(1, &ring.instanced_vao);
+
+    ring.frame_index = 0;
+    ring.frame_used = 0;
+    memset(ring.fences, 0, sizeof(ring.fences));
+    
+    printf("Streaming mode enabled\n");
+}
+
+static void tgui_opengl_ring_terminate(void) {
+    if(!ring.enable) return;
+
+    for(tgui_u32 i = 0; i < TGUI_OPENGL_RING_FRAMES; ++i) {
+        if(ring.fences[i]) tgui_opengl_wait_fence(ring.fences[i]);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, ring.buffer);
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+    glDeleteBuffers(1, &ring.buffer);
+    glDeleteVertexArrays(1, &ring.vao);
+    glDeleteVertexArrays(1, &ring.instanced_vao);
+}
+
+/* NOTE: Return the offset of a block of size bytes in the current frame segment, the
+   block is aligned to sizeof(TGuiVertex) so it can be used as a base vertex, this is
+   also a multiple of 4 so it is a valid offset for the instance attributes */
+static tgui_u64 tgui_opengl_ring_alloc(tgui_u64 size) {
+    
+    ASSERT(size <= TGUI_OPENGL_RING_FRAME_SIZE);
+    
+    tgui_u64 align = sizeof(TGuiVertex);
+    tgui_u64 offset = ((ring.frame_used + (align - 1)) / align) * align;
+
+    if(offset + size > TGUI_OPENGL_RING_FRAME_SIZE) {
+        /* NOTE: The frame segment is full, wait for the draws already issued from it */
+        tgui_opengl_wait_fence(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+        offset = 0;
+    }
+    
+    ring.frame_used = offset + size;
+
+    return (ring.frame_index * TGUI_OPENGL_RING_FRAME_SIZE) + offset;
+}
+
+void tgui_opengl_begin_frame(void) {
+    if(!ring.enable) return;
+
+    GLsync fence = ring.fences[ring.frame_index];
+    if(fence) {
+        tgui_opengl_wait_fence(fence);
+        ring.fences[ring.frame_index] = 0;
+    }
+    ring.frame_used = 0;
+}
+
+void tgui_opengl_end_frame(void) {
+    /* NOTE: Leave the scissor test disable for the glClear of the next frame */
+    glDisable(GL_SCISSOR_TEST);
+
+    if(!ring.enable) return;
+
+    ring.fences[ring.frame_index] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    ring.frame_index = (ring.frame_index + 1) % TGUI_OPENGL_RING_FRAMES;
+}
+
 void tgui_opengl_initialize_buffers(void) {
 
     glEnable(GL_BLEND);
@@ -474,24 +731,48 @@ void tgui_opengl_initialize_buffers(void) {
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
     glBufferData(GL_ARRAY_BUFFER, MAX_QUAD_PER_BATCH*(sizeof(TGuiVertex) * 4), 0, GL_DYNAMIC_DRAW); 
     
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(TGuiVertex), TGUI_OFFSET_OF(TGuiVertex, x)); 
-
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(TGuiVertex), TGUI_OFFSET_OF(TGuiVertex, u)); 
-
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(TGuiVertex), TGUI_OFFSET_OF(TGuiVertex, r)); 
+    tgui_opengl_setup_vertex_attributes();
 
     glGenBuffers(1, &ebo);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, MAX_QUAD_PER_BATCH*(sizeof(tgui_u32) * 6), 0, GL_DYNAMIC_DRAW); 
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, MAX_QUAD_PER_BATCH*(sizeof(tgui_u16) * 6), 0, GL_STATIC_DRAW); 
+    ebo_indices = NULL;
+    
+    glGenVertexArrays(1, &instanced_vao);
+    glBindVertexArray(instanced_vao);
+
+    glGenBuffers(1, &instanced_vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, instanced_vbo);
+    glBufferData(GL_ARRAY_BUFFER, MAX_QUAD_PER_BATCH*sizeof(TGuiQuadInstance), 0, GL_DYNAMIC_DRAW); 
+
+    tgui_opengl_setup_instance_attributes(0);
+
+    glBindVertexArray(vao);
+
+    tgui_opengl_ring_initialize();
+    glBindVertexArray(vao);
     
     /* ------------------------------------------------ */
     /*       FrameBuffer test                           */
 
+    glGenVertexArrays(1, &tri_vao);
+    glBindVertexArray(tri_vao);
+
+    glGenBuffers(1, &tri_vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, tri_vbo);
+    glBufferData(GL_ARRAY_BUFFER, 3*sizeof(TriangleVertex), 0, GL_DYNAMIC_DRAW); 
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(TriangleVertex), TGUI_OFFSET_OF(TriangleVertex, x)); 
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(TriangleVertex), TGUI_OFFSET_OF(TriangleVertex, u)); 
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(TriangleVertex), TGUI_OFFSET_OF(TriangleVertex, r)); 
+    
+    glBindVertexArray(vao);
+
     custom_program = tgui_opengl_create_program("./shaders/triangle.vert", "./shaders/triangle.frag");
-    custom_texture = tgui_opengl_create_texture(NULL, 1024, 1024);
+    custom_texture = tgui_opengl_create_texture(NULL, 1024, 1024, 1);
 
     glGenRenderbuffers(1, &rbo);
     glBindRenderbuffer(GL_RENDERBUFFER, rbo);
@@ -500,7 +781,7 @@ void tgui_opengl_initialize_buffers(void) {
 
     glGenFramebuffers(1, &fbo);
     glBindFramebuffer(GL_FRAMEBUFFER, fbo);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, (tgui_u64)custom_texture, 0);
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, (tgui_u64)custom_texture, 0, 0);
     glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, rbo);
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
@@ -508,28 +789,94 @@ void tgui_opengl_initialize_buffers(void) {
 
 }
 
-void tgui_opengl_draw_buffers(void *program, void *texture, TGuiVertexArray *vertex_buffer, TGuiU32Array *index_buffer) {
+void tgui_opengl_terminate_buffers(void) {
+    tgui_opengl_ring_terminate();
+}
+
+/* NOTE: tgui passes the same table of quad indices to every draw, it is uploaded to ebo the first
+   time it is seen. Both vertex arrays use ebo so only the vertices are copied in each draw */
+static void tgui_opengl_upload_quad_indices(void *indices) {
+    if(indices == ebo_indices) return;
+    
+    glBindVertexArray(vao);
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, MAX_QUAD_PER_BATCH*(sizeof(tgui_u16) * 6), indices);
+    ebo_indices = indices;
+}
+
+static void tgui_opengl_draw_buffers_streaming(TGuiVertex *vertices, tgui_u32 vertices_count, tgui_u32 indices_count) {
 
-        ASSERT(tgui_array_size(vertex_buffer) <= MAX_QUAD_PER_BATCH*4);
-        ASSERT(tgui_array_size(index_buffer)  <= MAX_QUAD_PER_BATCH*6);
+        tgui_u64 vertices_size = vertices_count*sizeof(TGuiVertex);
+        tgui_u64 vertex_offset = tgui_opengl_ring_alloc(vertices_size);
+        memcpy(ring.memory + vertex_offset, vertices, vertices_size);
+
+        glBindVertexArray(ring.vao);
+        
+        tgui_s32 base_vertex = (tgui_s32)(vertex_offset / sizeof(TGuiVertex));
+        glDrawElementsBaseVertex(GL_TRIANGLES, indices_count, GL_UNSIGNED_SHORT, 0, base_vertex);
+}
+
+void tgui_opengl_draw_buffers(void *program, void *texture, tgui_b32 sdf, TGuiVertex *vertices, tgui_u32 vertices_count, void *indices, tgui_u32 indices_count, tgui_u32 index_size) {
+
+        /* NOTE: The sdf programs sample the texture as a signed distance field */
+        TGUI_UNUSED(sdf);
+
+        ASSERT(vertices_count <= MAX_QUAD_PER_BATCH*4);
+        ASSERT(indices_count  <= MAX_QUAD_PER_BATCH*6);
+        ASSERT(index_size == sizeof(tgui_u16)); TGUI_UNUSED(index_size);
         
         tgui_u32 program_id = (tgui_u64)program;
         glUseProgram(program_id);
 
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, tgui_array_size(vertex_buffer)*sizeof(TGuiVertex), tgui_array_data(vertex_buffer));
+        tgui_u32 texture_id = (tgui_u64)texture;
+        glBindTexture(GL_TEXTURE_2D_ARRAY, texture_id);
+
+        tgui_opengl_upload_quad_indices(indices);
         
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, tgui_array_size(index_buffer)*sizeof(tgui_u32), tgui_array_data(index_buffer));
+        if(ring.enable) {
+            tgui_opengl_draw_buffers_streaming(vertices, vertices_count, indices_count);
+            return;
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, vertices_count*sizeof(TGuiVertex), vertices);
 
         glBindVertexArray(vao);
+        glDrawElements(GL_TRIANGLES, indices_count, GL_UNSIGNED_SHORT, 0);
+
+}
+
+void tgui_opengl_draw_instances(void *program, void *texture, tgui_b32 sdf, TGuiQuadInstance *instances, tgui_u32 instances_count) {
+
+        TGUI_UNUSED(sdf);
+
+        ASSERT(instances_count <= MAX_QUAD_PER_BATCH);
         
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+        tgui_u32 program_id = (tgui_u64)program;
+        glUseProgram(program_id);
 
         tgui_u32 texture_id = (tgui_u64)texture;
-        glBindTexture(GL_TEXTURE_2D, texture_id);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, texture_id);
+
+        tgui_u64 instances_size = instances_count*sizeof(TGuiQuadInstance);
 
-        glDrawElements(GL_TRIANGLES, tgui_array_size(index_buffer), GL_UNSIGNED_INT, 0);
+        if(ring.enable) {
+            
+            tgui_u64 instances_offset = tgui_opengl_ring_alloc(instances_size);
+            memcpy(ring.memory + instances_offset, instances, instances_size);
+
+            glBindVertexArray(ring.instanced_vao);
+            glBindBuffer(GL_ARRAY_BUFFER, ring.buffer);
+            tgui_opengl_setup_instance_attributes(instances_offset);
+
+        } else {
+
+            glBindBuffer(GL_ARRAY_BUFFER, instanced_vbo);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, instances_size, instances);
+
+            glBindVertexArray(instanced_vao);
+        }
+
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, instances_count);
 
 }
 /* -------------------------------------------- */
@@ -582,8 +929,14 @@ int main(void) {
     gfx.destroy_program              = tgui_opengl_destroy_program;
     gfx.create_texture               = tgui_opengl_create_texture;
     gfx.destroy_texture              = tgui_opengl_destroy_texture;
+    gfx.create_texture_r8            = tgui_opengl_create_texture_r8;
+    gfx.update_texture               = tgui_opengl_update_texture;
+    gfx.update_texture_r8            = tgui_opengl_update_texture_r8;
     gfx.set_program_width_and_height = tgui_opengl_set_program_width_and_height;
+    gfx.set_clip                     = tgui_opengl_set_clip;
     gfx.draw_buffers                 = tgui_opengl_draw_buffers;
+    gfx.draw_instances               = tgui_opengl_draw_instances;
+    gfx.max_quads_per_batch          = MAX_QUAD_PER_BATCH;
     
     
     tgui_u64 miliseconds_per_frame = 16;
@@ -591,6 +944,7 @@ int main(void) {
     tgui_u64 last_time = os_get_ticks();
     
     tgui_initialize(1280, 720, &gfx);
+    tgui_set_skip_unchanged_frames(true);
     
     /* NOTE: Load custom textures here */
 
@@ -674,43 +1028,52 @@ int main(void) {
 
         /* NOTE: Rendering code Here!!! */
 
-        glViewport(0, 0, window->width, window->height);
+        if(tgui_frame_changed()) {
 
-        glClearColor(1.0f, 0.0f, 1.0f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
-         
-        tgui_draw_buffers();
+            glViewport(0, 0, window->width, window->height);
 
+            glClearColor(1.0f, 0.0f, 1.0f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+        
+            tgui_opengl_begin_frame();
+            tgui_draw_buffers();
+            tgui_opengl_end_frame();
 
-        /* ------------------------------------------------ */
-        /*       FrameBuffer test                           */
 
-        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
-        glViewport(0, 0, 1024, 1024);
+            /* ------------------------------------------------ */
+            /*       FrameBuffer test                           */
+
+            glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+            glViewport(0, 0, 1024, 1024);
 
-        glUseProgram((tgui_u64)custom_program);
+            glUseProgram((tgui_u64)custom_program);
         
-        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+            glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 
-        TGuiVertex tri_vertices[3] = {
-            {-0.5f, -0.5f,   0, 0,  1,0,0}, 
-            { 0.5f, -0.5f,   0, 1,  0,1,0}, 
-            { 0.0f,  0.5f,   1, 1,  0,0,1}, 
-        };
+            TriangleVertex tri_vertices[3] = {
+                {-0.5f, -0.5f,   0, 0,  1,0,0}, 
+                { 0.5f, -0.5f,   0, 1,  0,1,0}, 
+                { 0.0f,  0.5f,   1, 1,  0,0,1}, 
+            };
         
-        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
+            glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
 
-        glBindVertexArray(vao);
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, 3*sizeof(TGuiVertex), tri_vertices);
-        glDrawArrays(GL_TRIANGLES, 0, 3);
+            glBindVertexArray(tri_vao);
+            glBindBuffer(GL_ARRAY_BUFFER, tri_vbo);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, 3*sizeof(TriangleVertex), tri_vertices);
+            glDrawArrays(GL_TRIANGLES, 0, 3);
          
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-        /* ------------------------------------------------ */
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            /* ------------------------------------------------ */
 
 
-        os_gl_swap_buffers(window);
+            os_gl_swap_buffers(window);
+
+        } else {
+            /* NOTE: Nothing changed, keep presenting the last image */
+            tgui_draw_buffers();
+        }
 
         /* ------------------------------------------------ */
 
@@ -727,6 +1090,7 @@ int main(void) {
 
     tgui_terminate();
 
+    tgui_opengl_terminate_buffers();
     os_gl_destroy_context(window);
 
     os_terminate();
@@ -0,0 +1,220 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "tgui.h"
+#include "tgui_gfx_software.h"
+
+/* NOTE: Runs the sandbox widgets on the software gfx backend without a window, used to
+   profile and benchmark tgui on machines without GPU or X server. The painter is the instanced
+   one by default, indexed draws the quads with vertices and indices and software draws the frame
+   with the binned software painter in a framebuffer of the driver. The vertex format is chosen at
+   compile time, build.sh builds headless and headless_packed so the images of every path can be
+   compared. The mouse moves over the widgets every frame.
+
+   With the software painter only the damaged rows are presented, copied to a second buffer that
+   is the one written to the ppm, and the window drawn by the host is only drawn again when tgui
+   damaged it.
+   usage: headless [frames] [output.ppm] [instanced|indexed|software] */
+
+#define HEADLESS_WIDTH  1280
+#define HEADLESS_HEIGHT 720
+#define HEADLESS_HOST_COLOR 0xff305070
+
+static tgui_u64 headless_get_nanoseconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (tgui_u64)ts.tv_sec * 1000000000ull + (tgui_u64)ts.tv_nsec;
+}
+
+static void headless_write_ppm(const char *path, tgui_u32 *pixels, tgui_u32 width, tgui_u32 height) {
+
+    FILE *file = fopen(path, "wb");
+    if(!file) {
+        printf("Cannot write file: %s\n", path);
+        return;
+    }
+
+    fprintf(file, "P6\n%u %u\n255\n", width, height);
+    for(tgui_u32 i = 0; i < width*height; ++i) {
+        tgui_u8 rgb[3] = { (pixels[i] >> 16) & 0xff, (pixels[i] >> 8) & 0xff, (pixels[i] >> 0) & 0xff };
+        fwrite(rgb, sizeof(rgb), 1, file);
+    }
+
+    fclose(file);
+}
+
+int main(int argc, char **argv) {
+
+    tgui_u32 frames_count = (argc > 1) ? (tgui_u32)atoi(argv[1]) : 600;
+    const char *output_path = (argc > 2) ? argv[2] : NULL;
+    const char *painter_name = (argc > 3) ? argv[3] : "instanced";
+
+    TGuiGfxBackend gfx;
+    tgui_gfx_software_initialize(&gfx, HEADLESS_WIDTH, HEADLESS_HEIGHT);
+
+    tgui_u32 *framebuffer = NULL;
+
+    /* NOTE: Without draw_instances tgui uses the indexed painter */
+    if(strcmp(painter_name, "indexed") == 0) {
+        gfx.draw_instances = NULL;
+    } else if(strcmp(painter_name, "software") == 0) {
+        framebuffer = malloc(HEADLESS_WIDTH * HEADLESS_HEIGHT * sizeof(tgui_u32));
+    } else if(strcmp(painter_name, "instanced") != 0) {
+        printf("Unknown painter: %s\n", painter_name);
+        return 1;
+    }
+
+    tgui_initialize(HEADLESS_WIDTH, HEADLESS_HEIGHT, &gfx);
+    tgui_texture_atlas_generate_atlas();
+
+    if(framebuffer) {
+        tgui_set_software_framebuffer(framebuffer, HEADLESS_WIDTH, HEADLESS_HEIGHT);
+    }
+
+    TGuiWindowHandle window0 = tgui_create_root_window("Window 0", false);
+    TGuiWindowHandle window1 = tgui_split_window(window0, TGUI_SPLIT_DIR_HORIZONTAL, "Window 1", TGUI_WINDOW_TRANSPARENT);
+    TGuiWindowHandle window2 = tgui_split_window(window0, TGUI_SPLIT_DIR_VERTICAL,   "Window 2", TGUI_WINDOW_SCROLLING);
+    TGuiWindowHandle window3 = tgui_split_window(window1, TGUI_SPLIT_DIR_HORIZONTAL, "Window 3", TGUI_WINDOW_SCROLLING);
+    TGuiWindowHandle window4 = tgui_split_window(window3, TGUI_SPLIT_DIR_VERTICAL,   "Window 4", TGUI_WINDOW_SCROLLING);
+    TGuiWindowHandle window5 = tgui_split_window(window2, TGUI_SPLIT_DIR_VERTICAL,   "Window 5", TGUI_WINDOW_TRANSPARENT);
+
+    /* NOTE: Content of the host window, a texture of the gfx backend or pixels written to the software framebuffer */
+    tgui_u32 host_pixel = HEADLESS_HOST_COLOR;
+    void *host_texture = framebuffer ? NULL : gfx.create_texture(&host_pixel, 1, 1, 1);
+
+    tgui_u32 *presented = NULL;
+    tgui_u8 *presented_rows = NULL;
+    if(framebuffer) {
+        presented = malloc(HEADLESS_WIDTH * HEADLESS_HEIGHT * sizeof(tgui_u32));
+        presented_rows = malloc(HEADLESS_HEIGHT);
+        for(tgui_u32 i = 0; i < HEADLESS_WIDTH * HEADLESS_HEIGHT; ++i) framebuffer[i] = 0xffff00ff;
+    }
+    tgui_u64 presented_rows_count = 0;
+    tgui_u32 host_draws_count = 0;
+
+    char *options[] = {
+        "option 0",
+        "option 1",
+        "option 2",
+        "option 3",
+        "option 4",
+        "option 5",
+        "option 6",
+        "option 7",
+        "option 8",
+        "option 9",
+    };
+    tgui_s32 option_index = 0;
+
+    tgui_u64 frame_time = 0;
+    tgui_u64 draw_time = 0;
+
+    for(tgui_u32 frame = 0; frame < frames_count; ++frame) {
+
+        tgui_u64 frame_start = headless_get_nanoseconds();
+
+        TGuiInput *input = tgui_get_input();
+        input->mouse_x = (tgui_s32)((frame * 37) % HEADLESS_WIDTH);
+        input->mouse_y = (tgui_s32)((frame * 13) % HEADLESS_HEIGHT);
+
+        tgui_begin(16);
+
+        tgui_button(window0, "button", 10, 10);
+        tgui_button(window0, "button", 10, 60);
+        tgui_button(window3, "button", 10, 10);
+        tgui_button(window3, "button", 160, 10);
+        tgui_button(window3, "button", 310, 10);
+        tgui_button(window1, "button", 10, 10);
+        tgui_button(window2, "button", 10, 100);
+        tgui_button(window4, "button", 10, 10);
+
+        tgui_text_input(window2, 10, 10);
+        tgui_text_input(window2, 180, 10);
+
+        tgui_dropdown_menu(window2, 10, 60, options, sizeof(options)/sizeof(options[0]), &option_index);
+        tgui_dropdown_menu(window2, 180, 60, options, sizeof(options)/sizeof(options[0]), &option_index);
+
+        tgui_texture(window5, host_texture);
+
+        tgui_end();
+
+        if(framebuffer) {
+            TGuiDamage *damage = tgui_get_damage();
+            
+            if(tgui_window_is_damaged(window5)) {
+                TGuiRectangle dim = tgui_window_get_from_handle(window5)->dim;
+                for(tgui_s32 y = dim.min_y; y <= dim.max_y; ++y) {
+                    for(tgui_s32 x = dim.min_x; x <= dim.max_x; ++x) {
+                        framebuffer[y * HEADLESS_WIDTH + x] = HEADLESS_HOST_COLOR;
+                    }
+                }
+                tgui_damage_add(damage, dim);
+                ++host_draws_count;
+            }
+
+            memset(presented_rows, 0, HEADLESS_HEIGHT);
+            for(tgui_u32 i = 0; i < damage->rects_count; ++i) {
+                for(tgui_s32 y = damage->rects[i].min_y; y <= damage->rects[i].max_y; ++y) {
+                    presented_rows[y] = 1;
+                }
+            }
+            for(tgui_u32 y = 0; y < HEADLESS_HEIGHT; ++y) {
+                if(!presented_rows[y]) continue;
+                memcpy(presented + y * HEADLESS_WIDTH, framebuffer + y * HEADLESS_WIDTH, HEADLESS_WIDTH * sizeof(tgui_u32));
+                ++presented_rows_count;
+            }
+        }
+
+        tgui_u64 draw_start = headless_get_nanoseconds();
+
+        if(!framebuffer) {
+            tgui_gfx_software_clear(0xffff00ff);
+            tgui_draw_buffers();
+        }
+
+        tgui_u64 frame_end = headless_get_nanoseconds();
+
+        frame_time += frame_end - frame_start;
+        draw_time += frame_end - draw_start;
+    }
+
+    if(frames_count > 0) {
+#ifdef TGUI_PACKED_VERTEX
+        const char *vertex_format = "packed";
+#else
+        const char *vertex_format = "float";
+#endif
+        printf("painter: %s, vertex: %s\n", painter_name, vertex_format);
+        printf("frames: %u, frame: %.3f ms, draw: %.3f ms\n", frames_count,
+               (tgui_f64)frame_time / (tgui_f64)frames_count / 1000000.0,
+               (tgui_f64)draw_time / (tgui_f64)frames_count / 1000000.0);
+        if(framebuffer) {
+            printf("presented rows: %.1f per frame, host window draws: %u\n",
+                   (tgui_f64)presented_rows_count / (tgui_f64)frames_count, host_draws_count);
+        }
+    }
+
+    if(output_path) {
+        if(framebuffer) {
+            headless_write_ppm(output_path, presented, HEADLESS_WIDTH, HEADLESS_HEIGHT);
+        } else {
+            tgui_u32 width, height;
+            tgui_u32 *pixels = tgui_gfx_software_get_pixels(&width, &height);
+            headless_write_ppm(output_path, pixels, width, height);
+        }
+    }
+
+    if(host_texture) {
+        gfx.destroy_texture(host_texture);
+    }
+
+    tgui_terminate();
+    tgui_gfx_software_terminate();
+    free(presented_rows);
+    free(presented);
+    free(framebuffer);
+
+    return 0;
+}
@@ -15,6 +15,8 @@
 #define glTexParameteri glTexParameteriOld
 #define glDeleteTextures glDeleteTexturesOld
 #define glTexImage2D glTexImage2DOld 
+#define glTexImage3D glTexImage3DOld
+#define glTexSubImage3D glTexSubImage3DOld
 #include <GL/gl.h>
 #undef glGetTexImage
 #undef glTexSubImage2D
@@ -28,6 +30,8 @@
 #undef glTexParameteri
 #undef glDeleteTextures
 #undef glTexImage2D
+#undef glTexImage3D
+#undef glTexSubImage3D
 
 #include <GL/glx.h>
 
@@ -42,6 +46,7 @@
   X(void, glGenFramebuffers, (GLsizei n, GLuint *ids)) \
   X(void, glBindFramebuffer, (GLenum target, GLuint framebuffer)) \
   X(void, glFramebufferTexture2D, (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)) \
+  X(void, glFramebufferTextureLayer, (GLenum target, GLenum attachment, GLuint texture, GLint level, GLint layer)) \
   X(void, glGenRenderbuffers, (GLsizei n, GLuint *renderbuffers)) \
   X(void, glBindRenderbuffer, (GLenum target, GLuint renderbuffer)) \
   X(void, glRenderbufferStorage, (GLenum target, GLenum internalformat, GLsizei width, GLsizei height)) \
@@ -88,7 +93,17 @@
   X(void, glTexParameteri, (GLenum target, GLenum	pname, GLint	param)) \
   X(void, glDeleteTextures, (GLsizei	n, const GLuint *textures)) \
   X(void, glTexImage2D, (GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const GLvoid * data)) \
-  X(void, glBlitFramebuffer, (GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter))
+  X(void, glTexImage3D, (GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const GLvoid * data)) \
+  X(void, glTexSubImage3D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const GLvoid *data)) \
+  X(void, glBlitFramebuffer, (GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter)) \
+  X(const GLubyte *, glGetStringi, (GLenum name, GLuint index)) \
+  X(void, glBufferStorage, (GLenum target, GLsizeiptr size, const GLvoid *data, GLbitfield flags)) \
+  X(void *, glMapBufferRange, (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)) \
+  X(GLboolean, glUnmapBuffer, (GLenum target)) \
+  X(GLsync, glFenceSync, (GLenum condition, GLbitfield flags)) \
+  X(GLenum, glClientWaitSync, (GLsync sync, GLbitfield flags, GLuint64 timeout)) \
+  X(void, glDeleteSync, (GLsync sync)) \
+  X(void, glDrawElementsBaseVertex, (GLenum mode, GLsizei count, GLenum type, const GLvoid *indices, GLint basevertex))
 
 #define TGUI_GL_PROC(name) TGUI_##name##_PROC
 
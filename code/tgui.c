@@ -7,6 +7,7 @@
 #include "tgui_os.h"
 
 #include <stdio.h>
+#include <time.h>
 
 /* -------------------------- */
 /*       Hash Function     */
@@ -56,7 +57,7 @@ tgui_u64 murmur_hash64A(const void * key, int len, tgui_u64 seed);
 
 TGui state;
 TGuiInput input;
-TGuiFont font;
+TGuiFontRegistry font_registry;
 extern TGuiDocker docker;
 
 
@@ -72,118 +73,919 @@ tgui_u64 tgui_hash(void *bytes, tgui_u64 size) {
     return murmur_hash64A(bytes, size, 123);
 }
 
+tgui_u64 tgui_hash_seed(void *bytes, tgui_u64 size, tgui_u64 seed) {
+    return murmur_hash64A(bytes, size, seed);
+}
+
 /* ---------------------- */
 /*       TGui Font        */
 /* ---------------------- */
 
-static tgui_u32 get_codepoint_index(tgui_u32 codepoint) {
+#define TGUI_UTF8_REPLACEMENT_CHARACTER 0xfffd
+
+tgui_u32 tgui_utf8_decode(char *text, tgui_u32 size, tgui_u32 *codepoint) {
     
-    if((codepoint < font.glyph_rage_start) || (codepoint > font.glyph_rage_end)) {
-        codepoint = (tgui_u32)'?';
+    TGUI_ASSERT(size > 0);
+    tgui_u8 *bytes = (tgui_u8 *)text;
+    
+    tgui_u32 length = 0;
+    tgui_u32 result = 0;
+    tgui_u32 min_codepoint = 0;
+
+    if(bytes[0] < 0x80) {
+        *codepoint = bytes[0];
+        return 1;
+    } else if((bytes[0] & 0xe0) == 0xc0) {
+        length = 2; result = bytes[0] & 0x1f; min_codepoint = 0x80;
+    } else if((bytes[0] & 0xf0) == 0xe0) {
+        length = 3; result = bytes[0] & 0x0f; min_codepoint = 0x800;
+    } else if((bytes[0] & 0xf8) == 0xf0) {
+        length = 4; result = bytes[0] & 0x07; min_codepoint = 0x10000;
+    }
+
+    if(length == 0 || length > size) {
+        *codepoint = TGUI_UTF8_REPLACEMENT_CHARACTER;
+        return 1;
+    }
+
+    for(tgui_u32 i = 1; i < length; ++i) {
+        if((bytes[i] & 0xc0) != 0x80) {
+            *codepoint = TGUI_UTF8_REPLACEMENT_CHARACTER;
+            return 1;
+        }
+        result = (result << 6) | (bytes[i] & 0x3f);
     }
 
-    tgui_u32 index = (codepoint - font.glyph_rage_start);
-    return index;
+    /* NOTE: Overlong encodings, surrogates and out of range values are invalid */
+    if(result < min_codepoint || result > 0x10ffff || (result >= 0xd800 && result <= 0xdfff)) {
+        *codepoint = TGUI_UTF8_REPLACEMENT_CHARACTER;
+        return 1;
+    }
+
+    *codepoint = result;
+    return length;
 }
 
-void tgui_font_initilize(TGuiArena *arena) {
+static void font_raster_glyph_job(void *data, tgui_u32 index) {
     
-    struct TGuiOsFont *os_font = tgui_os_font_create(arena, "/usr/share/fonts/truetype/liberation2/LiberationMono-Regular.ttf", 18);
-    //struct OsFont *os_font = os_font_create(arena, "/usr/share/fonts/truetype/noto/NotoSansMono-Regular.ttf", 18);
+    TGuiGlyphRasterJob *job = (TGuiGlyphRasterJob *)data + index;
     
-    font.glyph_rage_start = 32;
-    font.glyph_rage_end = 126;
-    font.glyph_count = (font.glyph_rage_end - font.glyph_rage_start + 1);
-    font.glyphs = tgui_arena_push_array(arena, TGuiGlyph, font.glyph_count, 8);
-    tgui_os_font_get_vmetrics(os_font, &font.ascent, &font.descent, &font.line_gap);
+    if(job->sdf) {
+        tgui_os_font_rasterize_glyph_sdf(job->font, job->codepoint, TGUI_SDF_PADDING, TGUI_SDF_ON_EDGE, TGUI_SDF_DISTANCE_SCALE, &job->buffer, &job->w, &job->h, &job->x_offset, &job->y_offset);
+    } else {
+        tgui_s32 bpp;
+        tgui_os_font_rasterize_glyph(job->font, job->codepoint, &job->buffer, &job->w, &job->h, &bpp);
+        TGUI_ASSERT(bpp == 1);
+        job->x_offset = 0;
+        job->y_offset = 0;
+    }
 
-    void *temp_buffer = tgui_arena_alloc(arena, 512*512, 8);
+    job->finished = true;
+}
 
-    for(tgui_u32 glyph_index = font.glyph_rage_start; glyph_index <= font.glyph_rage_end; ++glyph_index) {
-        
-        tgui_s32 w, h, bpp;
-        tgui_os_font_rasterize_glyph(os_font, glyph_index, &temp_buffer, &w, &h, &bpp);
+static void font_set_glyph(TGuiFont *font, TGuiGlyph *glyph) {
+    tgui_u32 codepoint = (tgui_u32)glyph->codepoint;
+    if(codepoint < TGUI_FONT_ASCII_GLYPHS) {
+        font->ascii_glyphs[codepoint] = glyph;
+    } else {
+        tgui_virtual_map_insert(&font->glyph_map, codepoint, glyph);
+    }
+}
+
+static TGuiGlyph *font_find_glyph(TGuiFont *font, tgui_u32 codepoint) {
+    if(codepoint < TGUI_FONT_ASCII_GLYPHS) {
+        return font->ascii_glyphs[codepoint];
+    }
+    return tgui_virtual_map_find(&font->glyph_map, codepoint);
+}
+
+/* NOTE: Insert the coverage of a finished job in the atlas and free it */
+static TGuiGlyph *font_add_glyph(TGuiFont *font, TGuiGlyphRasterJob *job) {
+
+    TGuiGlyph *glyph = tgui_array_push(&font->glyphs);
+    glyph->codepoint = job->codepoint;
+    glyph->dim = tgui_glyph_atlas_insert(state.glyph_atlas, job->buffer, job->w, job->h);
+    font_registry.glyph_cache.glyphs_added = true;
+
+    if(job->buffer) {
+        tgui_os_font_free_glyph_buffer(job->font, job->buffer);
+    }
+
+    tgui_os_font_get_glyph_metrics(font->font, job->codepoint, &glyph->adv_width, &glyph->left_bearing, &glyph->top_bearing);
+    font_set_glyph(font, glyph);
+
+    return glyph;
+}
+
+/* NOTE: The field is rasterized once per face, the glyph of the font only scales it */
+static TGuiGlyph *font_face_add_sdf_glyph(TGuiFontFace *face, TGuiGlyphRasterJob *job) {
+
+    TGuiGlyph *sdf_glyph = tgui_array_push(&face->sdf_glyphs);
+    sdf_glyph->codepoint = job->codepoint;
+    sdf_glyph->dim = tgui_glyph_atlas_insert(state.sdf_glyph_atlas, job->buffer, job->w, job->h);
+    font_registry.glyph_cache.glyphs_added = true;
+    sdf_glyph->left_bearing = job->x_offset;
+    sdf_glyph->top_bearing = -job->y_offset;
+    sdf_glyph->adv_width = 0;
+
+    if(job->buffer) {
+        tgui_os_font_free_glyph_buffer(job->font, job->buffer);
+    }
+
+    tgui_virtual_map_insert(&face->sdf_glyph_map, job->codepoint, sdf_glyph);
+
+    return sdf_glyph;
+}
+
+static TGuiGlyph *font_add_sdf_glyph(TGuiFont *font, TGuiGlyph *sdf_glyph) {
+
+    TGuiGlyph *glyph = tgui_array_push(&font->glyphs);
+    glyph->codepoint = sdf_glyph->codepoint;
+    glyph->dim = sdf_glyph->dim;
+    glyph->left_bearing = (tgui_s32)floorf((tgui_f32)sdf_glyph->left_bearing * font->sdf_scale + 0.5f);
+    glyph->top_bearing = (tgui_s32)floorf((tgui_f32)sdf_glyph->top_bearing * font->sdf_scale + 0.5f);
     
-        TGuiGlyph *glyph = font.glyphs + (glyph_index - font.glyph_rage_start);
-        glyph->bitmap.pixels = tgui_arena_alloc(arena, sizeof(tgui_u32)*w*h, 8);
-        glyph->bitmap.width  = w;
-        glyph->bitmap.height = h;
-        
-        memset(glyph->bitmap.pixels, 0, sizeof(tgui_u32)*w*h);
-        
-        tgui_u8 *src_row  = temp_buffer;
-        tgui_u32 *des_row = glyph->bitmap.pixels;
-        for(tgui_u32 y = 0; y < (tgui_u32)h; ++y) {
-            tgui_u8 *src  = src_row;
-            tgui_u32 *des = des_row;
-            for(tgui_u32 x = 0; x < (tgui_u32)w; ++x) { 
-                *des++ = 0x00ffffff | (*src++ << 24); 
+    tgui_s32 left_bearing, top_bearing;
+    tgui_os_font_get_glyph_metrics(font->font, sdf_glyph->codepoint, &glyph->adv_width, &left_bearing, &top_bearing);
+    font_set_glyph(font, glyph);
+
+    return glyph;
+}
+
+static void font_glyph_job_initialize(TGuiGlyphRasterJob *job, TGuiFont *font, tgui_u32 codepoint) {
+    memset(job, 0, sizeof(TGuiGlyphRasterJob));
+    job->codepoint = codepoint;
+    job->sdf = font->sdf;
+    if(font->sdf) {
+        TGuiFontFace *face = tgui_array_get_ptr(&font_registry.faces, font->face);
+        job->font = face->sdf_font;
+    } else {
+        job->font = font->font;
+    }
+}
+
+static TGuiGlyph *font_get_glyph(TGuiFont *font, tgui_u32 codepoint) {
+    
+    TGuiGlyph *glyph = font_find_glyph(font, codepoint);
+    if(glyph) return glyph;
+
+    if(!tgui_os_font_has_codepoint(font->font, codepoint) && codepoint != '?') {
+        return font_get_glyph(font, '?');
+    }
+
+    TGuiGlyphRasterJob job;
+    font_glyph_job_initialize(&job, font, codepoint);
+
+    if(font->sdf) {
+        TGuiFontFace *face = tgui_array_get_ptr(&font_registry.faces, font->face);
+        TGuiGlyph *sdf_glyph = tgui_virtual_map_find(&face->sdf_glyph_map, codepoint);
+        if(!sdf_glyph) {
+            font_raster_glyph_job(&job, 0);
+            sdf_glyph = font_face_add_sdf_glyph(face, &job);
+        }
+        return font_add_sdf_glyph(font, sdf_glyph);
+    }
+
+    font_raster_glyph_job(&job, 0);
+    return font_add_glyph(font, &job);
+}
+
+static int font_compare_glyph_jobs(const void *a, const void *b) {
+    tgui_u32 codepoint_a = ((const TGuiGlyphRasterJob *)a)->codepoint;
+    tgui_u32 codepoint_b = ((const TGuiGlyphRasterJob *)b)->codepoint;
+    return (codepoint_a > codepoint_b) - (codepoint_a < codepoint_b);
+}
+
+/* NOTE: The missing glyphs are rasterized by the worker pool and inserted in the atlas in
+   codepoint order after all of them finish, so the atlas does not depend on the threads */
+static void font_load_glyphs(TGuiFont *font, tgui_u32 *codepoints, tgui_u32 count) {
+    
+    TGuiFontFace *face = tgui_array_get_ptr(&font_registry.faces, font->face);
+    TGuiGlyphRasterJobArray *jobs = &font_registry.raster_jobs;
+    tgui_array_clear(jobs);
+
+    for(tgui_u32 i = 0; i < count; ++i) {
+        tgui_u32 codepoint = codepoints[i];
+        if(font_find_glyph(font, codepoint)) continue;
+        if(!tgui_os_font_has_codepoint(font->font, codepoint)) continue;
+        if(font->sdf && tgui_virtual_map_contains(&face->sdf_glyph_map, codepoint)) continue;
+        font_glyph_job_initialize(tgui_array_push(jobs), font, codepoint);
+    }
+    
+    tgui_u32 jobs_count = tgui_array_size(jobs);
+    if(jobs_count > 0) {
+        qsort(tgui_array_data(jobs), jobs_count, sizeof(TGuiGlyphRasterJob), font_compare_glyph_jobs);
+    }
+
+    /* NOTE: Repeated codepoints are rasterized only once */
+    tgui_u32 unique_count = 0;
+    for(tgui_u32 i = 0; i < jobs_count; ++i) {
+        TGuiGlyphRasterJob *job = tgui_array_get_ptr(jobs, i);
+        if(unique_count > 0 && tgui_array_get_ptr(jobs, unique_count - 1)->codepoint == job->codepoint) continue;
+        *tgui_array_get_ptr(jobs, unique_count++) = *job;
+    }
+
+    tgui_os_parallel_for(font_raster_glyph_job, tgui_array_data(jobs), unique_count);
+
+    for(tgui_u32 i = 0; i < unique_count; ++i) {
+        TGuiGlyphRasterJob *job = tgui_array_get_ptr(jobs, i);
+        TGUI_ASSERT(job->finished && (job->buffer || job->w == 0 || job->h == 0));
+        if(font->sdf) {
+            font_face_add_sdf_glyph(face, job);
+        } else {
+            font_add_glyph(font, job);
+        }
+    }
+    
+    tgui_array_clear(jobs);
+    
+    /* NOTE: The glyphs of sdf fonts only scale the fields of the face */
+    if(font->sdf) {
+        for(tgui_u32 i = 0; i < count; ++i) {
+            if(!tgui_os_font_has_codepoint(font->font, codepoints[i])) continue;
+            font_get_glyph(font, codepoints[i]);
+        }
+    }
+}
+
+static tgui_s32 font_get_kerning(TGuiFont *font, tgui_u32 codepoint0, tgui_u32 codepoint1) {
+    
+    if(!font->has_kerning) return 0;
+
+    if(codepoint0 >= TGUI_FONT_KERNING_FIRST && codepoint0 <= TGUI_FONT_KERNING_LAST &&
+       codepoint1 >= TGUI_FONT_KERNING_FIRST && codepoint1 <= TGUI_FONT_KERNING_LAST) {
+        return font->kerning_table[(codepoint0 - TGUI_FONT_KERNING_FIRST) * TGUI_FONT_KERNING_COUNT + (codepoint1 - TGUI_FONT_KERNING_FIRST)];
+    }
+
+    tgui_u64 key = ((tgui_u64)codepoint0 << 32) | (tgui_u64)codepoint1;
+    tgui_s32 *kerning = tgui_virtual_map_find(&font->kerning_map, key);
+    if(!kerning) {
+        kerning = tgui_arena_push_struct(font_registry.arena, tgui_s32, 4);
+        *kerning = tgui_os_font_get_kerning_between(font->font, codepoint0, codepoint1);
+        tgui_virtual_map_insert(&font->kerning_map, key, kerning);
+    }
+
+    return *kerning;
+}
+
+/* ---------------------- */
+/*    TGui Glyph Cache    */
+/* ---------------------- */
+
+static tgui_b32 glyph_cache_atlas_valid(TGuiGlyphCacheAtlas *atlas) {
+    return atlas->width == TGUI_GLYPH_ATLAS_WIDTH && atlas->height > 0 &&
+           atlas->current_x <= atlas->width && atlas->current_y + atlas->row_height <= atlas->height;
+}
+
+static tgui_b32 glyph_cache_glyph_valid(TGuiGlyph *glyph, TGuiGlyphCacheAtlas *atlas) {
+    TGuiRectangle dim = glyph->dim;
+    if(tgui_rect_invalid(dim)) return true;
+    return dim.min_x >= 0 && dim.min_y >= 0 && dim.max_x >= dim.min_x && dim.max_y >= dim.min_y &&
+           (tgui_u32)dim.max_x < atlas->width && (tgui_u32)dim.max_y < atlas->height;
+}
+
+static char glyph_cache_host_path[TGUI_GLYPH_CACHE_PATH_SIZE];
+static tgui_b32 glyph_cache_host_path_set;
+
+void tgui_set_glyph_cache_path(char *path) {
+    glyph_cache_host_path_set = true;
+    glyph_cache_host_path[0] = '\0';
+    if(path) {
+        int length = snprintf(glyph_cache_host_path, sizeof(glyph_cache_host_path), "%s", path);
+        TGUI_ASSERT(length >= 0 && length < (int)sizeof(glyph_cache_host_path));
+        TGUI_UNUSED(length);
+    }
+}
+
+/* NOTE: Restore the glyph atlases from the cache file, it must run before any glyph is rasterized.
+   A missing file is the first run and is not reported */
+static void glyph_cache_load(void) {
+
+    TGuiGlyphCache *glyph_cache = &font_registry.glyph_cache;
+    memset(glyph_cache, 0, sizeof(TGuiGlyphCache));
+
+    if(glyph_cache_host_path_set) {
+        memcpy(glyph_cache->path, glyph_cache_host_path, sizeof(glyph_cache->path));
+    } else if(!tgui_os_get_cache_path(glyph_cache->path, sizeof(glyph_cache->path), TGUI_GLYPH_CACHE_FILE_NAME)) {
+        glyph_cache->path[0] = '\0';
+    }
+    
+    char *path = glyph_cache->path;
+    if(!path[0] || !tgui_os_file_exists(path)) return;
+
+    TGuiOsFile *file = tgui_os_file_map(path, TGUI_OS_FILE_ACCESS_SEQUENTIAL);
+    if(!file) return;
+
+    TGuiGlyphCacheHeader *header = file->data;
+    tgui_b32 valid = file->size >= sizeof(TGuiGlyphCacheHeader) &&
+                     header->magic == TGUI_GLYPH_CACHE_MAGIC && header->version == TGUI_GLYPH_CACHE_VERSION &&
+                     glyph_cache_atlas_valid(&header->glyph_atlas) && glyph_cache_atlas_valid(&header->sdf_glyph_atlas);
+    
+    tgui_u64 glyph_atlas_size = 0;
+    tgui_u64 sdf_glyph_atlas_size = 0;
+    if(valid) {
+        glyph_atlas_size = (tgui_u64)header->glyph_atlas.width * header->glyph_atlas.height;
+        sdf_glyph_atlas_size = (tgui_u64)header->sdf_glyph_atlas.width * header->sdf_glyph_atlas.height;
+        valid = file->size == sizeof(TGuiGlyphCacheHeader) +
+                              (tgui_u64)header->sets_count * sizeof(TGuiGlyphCacheSet) +
+                              (tgui_u64)header->glyphs_count * sizeof(TGuiGlyph) +
+                              glyph_atlas_size + sdf_glyph_atlas_size;
+    }
+
+    TGuiGlyphCacheSet *sets = (TGuiGlyphCacheSet *)(header + 1);
+    TGuiGlyph *glyphs = (TGuiGlyph *)(sets + (valid ? header->sets_count : 0));
+    for(tgui_u32 i = 0; valid && i < header->sets_count; ++i) {
+        TGuiGlyphCacheSet *set = sets + i;
+        valid = set->first_glyph <= header->glyphs_count && set->glyphs_count <= header->glyphs_count - set->first_glyph;
+        TGuiGlyphCacheAtlas *atlas = set->sdf ? &header->sdf_glyph_atlas : &header->glyph_atlas;
+        for(tgui_u32 j = 0; valid && j < set->glyphs_count; ++j) {
+            valid = glyph_cache_glyph_valid(glyphs + set->first_glyph + j, atlas);
+        }
+    }
+
+    if(!valid) {
+        printf("%s file old or corrupted\n", path);
+        tgui_os_file_free(file);
+        return;
+    }
+
+    tgui_u8 *glyph_atlas_pixels = (tgui_u8 *)(glyphs + header->glyphs_count);
+    tgui_u8 *sdf_glyph_atlas_pixels = glyph_atlas_pixels + glyph_atlas_size;
+
+    TGuiGlyphCacheAtlas *atlas = &header->glyph_atlas;
+    tgui_glyph_atlas_restore(state.glyph_atlas, glyph_atlas_pixels, atlas->height, atlas->current_x, atlas->current_y, atlas->row_height);
+    atlas = &header->sdf_glyph_atlas;
+    tgui_glyph_atlas_restore(state.sdf_glyph_atlas, sdf_glyph_atlas_pixels, atlas->height, atlas->current_x, atlas->current_y, atlas->row_height);
+
+    glyph_cache->file = file;
+    glyph_cache->sets = sets;
+    glyph_cache->sets_count = header->sets_count;
+    glyph_cache->glyphs = glyphs;
+}
+
+static TGuiGlyphCacheSet *glyph_cache_get_loaded_set(tgui_u64 file_hash, tgui_u32 size, tgui_b32 sdf) {
+    TGuiGlyphCache *glyph_cache = &font_registry.glyph_cache;
+    for(tgui_u32 i = 0; i < glyph_cache->sets_count; ++i) {
+        TGuiGlyphCacheSet *set = glyph_cache->sets + i;
+        if(set->file_hash == file_hash && set->size == size && set->sdf == sdf) return set;
+    }
+    return NULL;
+}
+
+static TGuiGlyph *glyph_cache_find_loaded_set(tgui_u64 file_hash, tgui_u32 size, tgui_b32 sdf, tgui_u32 *glyphs_count) {
+    TGuiGlyphCacheSet *set = glyph_cache_get_loaded_set(file_hash, size, sdf);
+    if(!set) return NULL;
+    *glyphs_count = set->glyphs_count;
+    return font_registry.glyph_cache.glyphs + set->first_glyph;
+}
+
+/* NOTE: Glyphs of a set in the fonts created in this run or in the loaded cache */
+static TGuiGlyph *glyph_cache_find_set(tgui_u64 file_hash, tgui_u32 size, tgui_b32 sdf, tgui_u32 *glyphs_count) {
+
+    if(sdf) {
+        for(tgui_u32 i = 0; i < tgui_array_size(&font_registry.faces); ++i) {
+            TGuiFontFace *face = tgui_array_get_ptr(&font_registry.faces, i);
+            if(face->sdf_font && face->file_hash == file_hash && size == TGUI_FONT_SDF_SIZE) {
+                *glyphs_count = tgui_array_size(&face->sdf_glyphs);
+                return tgui_array_data(&face->sdf_glyphs);
             }
-            src_row += w;
-            des_row += w;
         }
+    } else {
+        for(tgui_u32 i = 0; i < tgui_array_size(&font_registry.fonts); ++i) {
+            TGuiFont *font = tgui_array_get_ptr(&font_registry.fonts, i);
+            TGuiFontFace *face = tgui_array_get_ptr(&font_registry.faces, font->face);
+            if(!font->sdf && face->file_hash == file_hash && font->size == size) {
+                *glyphs_count = tgui_array_size(&font->glyphs);
+                return tgui_array_data(&font->glyphs);
+            }
+        }
+    }
+
+    return glyph_cache_find_loaded_set(file_hash, size, sdf, glyphs_count);
+}
+
+static tgui_b32 glyph_cache_has_set(TGuiGlyphCacheSetArray *sets, tgui_u64 file_hash, tgui_u32 size, tgui_b32 sdf) {
+    for(tgui_u32 i = 0; i < tgui_array_size(sets); ++i) {
+        TGuiGlyphCacheSet *set = tgui_array_get_ptr(sets, i);
+        if(set->file_hash == file_hash && set->size == size && set->sdf == sdf) return true;
+    }
+    return false;
+}
+
+/* NOTE: Copy the glyphs of the set at the end of glyphs, returns NULL if the set was already added */
+static TGuiGlyphCacheSet *glyph_cache_add_set(TGuiGlyphCacheSetArray *sets, TGuiGlyphArray *glyphs, tgui_u64 file_hash, tgui_u32 size, tgui_b32 sdf) {
+    
+    if(glyph_cache_has_set(sets, file_hash, size, sdf)) return NULL;
+    
+    TGuiGlyphCacheSet *set = tgui_array_push(sets);
+    memset(set, 0, sizeof(TGuiGlyphCacheSet));
+    set->file_hash = file_hash;
+    set->size = size;
+    set->sdf = sdf;
+    set->first_glyph = tgui_array_size(glyphs);
+    TGuiGlyph *set_glyphs = glyph_cache_find_set(file_hash, size, sdf, &set->glyphs_count);
+    
+    for(tgui_u32 i = 0; i < set->glyphs_count; ++i) {
+        TGuiGlyph *glyph = tgui_array_push(glyphs);
+        *glyph = set_glyphs[i];
+    }
+
+    return set;
+}
+
+/* NOTE: Add a set used in this run, returns true if the file has to be written to save it */
+static tgui_b32 glyph_cache_add_used_set(TGuiGlyphCacheSetArray *sets, TGuiGlyphArray *glyphs, tgui_u64 file_hash, tgui_u32 size, tgui_b32 sdf, tgui_u64 now) {
+    
+    TGuiGlyphCacheSet *set = glyph_cache_add_set(sets, glyphs, file_hash, size, sdf);
+    if(!set) return false;
+    
+    set->last_used = now;
+    TGuiGlyphCacheSet *loaded_set = glyph_cache_get_loaded_set(file_hash, size, sdf);
+    if(loaded_set && loaded_set->last_used <= now && now - loaded_set->last_used < TGUI_GLYPH_CACHE_USED_TIME_STEP) {
+        set->last_used = loaded_set->last_used;
+        return false;
+    }
+
+    return true;
+}
+
+static void glyph_cache_write_atlas_header(TGuiGlyphCacheAtlas *cache_atlas, TGuiGlyphAtlas *glyph_atlas) {
+    cache_atlas->width = glyph_atlas->width;
+    /* NOTE: Only the used rows of the atlas are saved */
+    cache_atlas->height = glyph_atlas->current_y + glyph_atlas->row_height;
+    cache_atlas->current_x = glyph_atlas->current_x;
+    cache_atlas->current_y = glyph_atlas->current_y;
+    cache_atlas->row_height = glyph_atlas->row_height;
+}
+
+/* NOTE: The file is written in a temporary file next to path and renamed, so other processes never
+   load a partial file. It is only written if a glyph was added, a set was pruned or the time of a
+   used set has to be refreshed */
+static void glyph_cache_save(void) {
+
+    TGuiGlyphCache *glyph_cache = &font_registry.glyph_cache;
+    char *path = glyph_cache->path;
+    if(!path[0]) return;
+
+    TGuiGlyphCacheSetArray sets;
+    tgui_array_initialize(&sets);
+    TGuiGlyphArray glyphs;
+    tgui_array_initialize(&glyphs);
+
+    tgui_u64 now = (tgui_u64)time(NULL);
+    tgui_b32 changed = glyph_cache->glyphs_added;
+
+    for(tgui_u32 i = 0; i < tgui_array_size(&font_registry.fonts); ++i) {
+        TGuiFont *font = tgui_array_get_ptr(&font_registry.fonts, i);
+        if(font->sdf) continue;
+        TGuiFontFace *face = tgui_array_get_ptr(&font_registry.faces, font->face);
+        changed |= glyph_cache_add_used_set(&sets, &glyphs, face->file_hash, font->size, false, now);
+    }
+    for(tgui_u32 i = 0; i < tgui_array_size(&font_registry.faces); ++i) {
+        TGuiFontFace *face = tgui_array_get_ptr(&font_registry.faces, i);
+        if(!face->sdf_font) continue;
+        changed |= glyph_cache_add_used_set(&sets, &glyphs, face->file_hash, TGUI_FONT_SDF_SIZE, true, now);
+    }
+    
+    /* NOTE: The glyphs of the fonts that were not used in this run are still in the atlases, they
+       are saved again until they expire */
+    tgui_b32 pruned = false;
+    for(tgui_u32 i = 0; i < glyph_cache->sets_count; ++i) {
+        TGuiGlyphCacheSet *set = glyph_cache->sets + i;
+        if(glyph_cache_has_set(&sets, set->file_hash, set->size, set->sdf)) continue;
+        if(set->last_used < now && now - set->last_used > TGUI_GLYPH_CACHE_MAX_UNUSED_TIME) {
+            pruned = true;
+            continue;
+        }
+        TGuiGlyphCacheSet *saved_set = glyph_cache_add_set(&sets, &glyphs, set->file_hash, set->size, set->sdf);
+        saved_set->last_used = set->last_used;
+    }
+
+    if(!changed && !pruned) {
+        tgui_array_terminate(&glyphs);
+        tgui_array_terminate(&sets);
+        return;
+    }
+
+    /* NOTE: The glyphs of the pruned sets are dropped copying the saved glyphs in new atlases */
+    TGuiGlyphAtlas *glyph_atlas = state.glyph_atlas;
+    TGuiGlyphAtlas *sdf_glyph_atlas = state.sdf_glyph_atlas;
+    TGuiGlyphAtlas rebuilt_glyph_atlas;
+    TGuiGlyphAtlas rebuilt_sdf_glyph_atlas;
+    if(pruned) {
+        tgui_glyph_atlas_initialize(&rebuilt_glyph_atlas);
+        tgui_glyph_atlas_initialize(&rebuilt_sdf_glyph_atlas);
+        for(tgui_u32 i = 0; i < tgui_array_size(&sets); ++i) {
+            TGuiGlyphCacheSet *set = tgui_array_get_ptr(&sets, i);
+            TGuiGlyphAtlas *rebuilt_atlas = set->sdf ? &rebuilt_sdf_glyph_atlas : &rebuilt_glyph_atlas;
+            TGuiGlyphAtlas *source_atlas = set->sdf ? sdf_glyph_atlas : glyph_atlas;
+            for(tgui_u32 j = 0; j < set->glyphs_count; ++j) {
+                TGuiGlyph *glyph = tgui_array_get_ptr(&glyphs, set->first_glyph + j);
+                glyph->dim = tgui_glyph_atlas_copy(rebuilt_atlas, source_atlas, glyph->dim);
+            }
+        }
+        glyph_atlas = &rebuilt_glyph_atlas;
+        sdf_glyph_atlas = &rebuilt_sdf_glyph_atlas;
+    }
+
+    TGuiGlyphCacheHeader header;
+    memset(&header, 0, sizeof(TGuiGlyphCacheHeader));
+    header.magic = TGUI_GLYPH_CACHE_MAGIC;
+    header.version = TGUI_GLYPH_CACHE_VERSION;
+    glyph_cache_write_atlas_header(&header.glyph_atlas, glyph_atlas);
+    glyph_cache_write_atlas_header(&header.sdf_glyph_atlas, sdf_glyph_atlas);
+    header.sets_count = tgui_array_size(&sets);
+    header.glyphs_count = tgui_array_size(&glyphs);
+
+    char temp_path[TGUI_GLYPH_CACHE_PATH_SIZE + 8];
+    FILE *file = tgui_os_file_create_temp(path, temp_path, sizeof(temp_path));
+    
+    tgui_b32 success = file != NULL;
+    success = success && fwrite(&header, sizeof(TGuiGlyphCacheHeader), 1, file) == 1;
+    if(header.sets_count > 0) {
+        success = success && fwrite(tgui_array_data(&sets), sizeof(TGuiGlyphCacheSet), header.sets_count, file) == header.sets_count;
+    }
+    if(header.glyphs_count > 0) {
+        success = success && fwrite(tgui_array_data(&glyphs), sizeof(TGuiGlyph), header.glyphs_count, file) == header.glyphs_count;
+    }
+    success = success && fwrite(glyph_atlas->pixels, header.glyph_atlas.width, header.glyph_atlas.height, file) == header.glyph_atlas.height;
+    success = success && fwrite(sdf_glyph_atlas->pixels, header.sdf_glyph_atlas.width, header.sdf_glyph_atlas.height, file) == header.sdf_glyph_atlas.height;
+    
+    if(file) {
+        success = (fclose(file) == 0) && success;
+        if(success && rename(temp_path, path) != 0) {
+            remove(path);
+            success = rename(temp_path, path) == 0;
+        }
+        if(!success) remove(temp_path);
+    }
+    if(!success) {
+        printf("Cannot write file: %s\n", path);
+    }
+
+    if(pruned) {
+        tgui_glyph_atlas_terminate(&rebuilt_glyph_atlas, state.render_state.gfx);
+        tgui_glyph_atlas_terminate(&rebuilt_sdf_glyph_atlas, state.render_state.gfx);
+    }
+    tgui_array_terminate(&glyphs);
+    tgui_array_terminate(&sets);
+}
+
+static void glyph_cache_terminate(void) {
+    if(font_registry.glyph_cache.file) {
+        tgui_os_file_free(font_registry.glyph_cache.file);
+    }
+    memset(&font_registry.glyph_cache, 0, sizeof(TGuiGlyphCache));
+}
+
+/* ---------------------- */
+
+static void font_restore_cached_glyphs(TGuiGlyphArray *array, TGuiGlyph *cached_glyphs, tgui_u32 cached_glyphs_count) {
+    for(tgui_u32 i = 0; i < cached_glyphs_count; ++i) {
+        TGuiGlyph *glyph = tgui_array_push(array);
+        *glyph = cached_glyphs[i];
+    }
+}
+
+static TGuiFontFaceHandle font_face_create(char *path) {
+    
+    /* NOTE: The face font is only used to share the file, the size does not matter */
+    struct TGuiOsFont *os_font = tgui_os_font_create(font_registry.arena, path, TGUI_DEFAULT_FONT_SIZE);
+    if(!os_font) return TGUI_DEFAULT_FONT_FACE;
+
+    TGuiFontFaceHandle handle = tgui_array_size(&font_registry.faces);
+    TGuiFontFace *face = tgui_array_push(&font_registry.faces);
+    face->font = os_font;
+    face->sdf_font = NULL;
+
+    /* NOTE: The file is only hashed entirely if it has no head table, the checksum of the file in
+       the head table and the size identify it */
+    TGuiOsFile *file = tgui_os_font_get_file(os_font);
+    tgui_u32 head_size = 0;
+    void *head = tgui_os_font_get_head_table(os_font, &head_size);
+    face->file_hash = head ? tgui_hash_seed(head, head_size, file->size) : tgui_hash(file->data, file->size);
+
+    return handle;
+}
+
+static TGuiFontHandle font_create(TGuiFontFaceHandle face_handle, tgui_u32 pixel_size, tgui_b32 sdf) {
+    
+    TGuiFontFace *face = tgui_array_get_ptr(&font_registry.faces, face_handle);
+    
+    TGuiFontHandle handle = tgui_array_size(&font_registry.fonts);
+    TGuiFont *font = tgui_array_push(&font_registry.fonts);
+    memset(font, 0, sizeof(TGuiFont));
+
+    font->face = face_handle;
+    font->size = pixel_size;
+    font->sdf = sdf;
+    font->sdf_scale = (tgui_f32)pixel_size / (tgui_f32)TGUI_FONT_SDF_SIZE;
+    font->font = tgui_os_font_create_size(font_registry.arena, face->font, pixel_size);
+
+    if(sdf && !face->sdf_font) {
+        face->sdf_font = tgui_os_font_create_size(font_registry.arena, face->font, TGUI_FONT_SDF_SIZE);
+        tgui_virtual_map_initialize(&face->sdf_glyph_map);
+        tgui_array_initialize(&face->sdf_glyphs);
+        
+        tgui_u32 cached_glyphs_count = 0;
+        TGuiGlyph *cached_glyphs = glyph_cache_find_loaded_set(face->file_hash, TGUI_FONT_SDF_SIZE, true, &cached_glyphs_count);
+        font_restore_cached_glyphs(&face->sdf_glyphs, cached_glyphs, cached_glyphs_count);
+        for(tgui_u32 i = 0; i < tgui_array_size(&face->sdf_glyphs); ++i) {
+            TGuiGlyph *glyph = tgui_array_get_ptr(&face->sdf_glyphs, i);
+            tgui_virtual_map_insert(&face->sdf_glyph_map, (tgui_u32)glyph->codepoint, glyph);
+        }
+    }
 
-        tgui_os_font_get_glyph_metrics(os_font, glyph_index, &glyph->adv_width, &glyph->left_bearing, &glyph->top_bearing);
+    tgui_virtual_map_initialize(&font->glyph_map);
+    tgui_array_initialize(&font->glyphs);
+    
+    /* NOTE: The glyphs of sdf fonts only scale the sdf glyphs of the face, they are not cached */
+    if(!sdf) {
+        tgui_u32 cached_glyphs_count = 0;
+        TGuiGlyph *cached_glyphs = glyph_cache_find_loaded_set(face->file_hash, pixel_size, false, &cached_glyphs_count);
+        font_restore_cached_glyphs(&font->glyphs, cached_glyphs, cached_glyphs_count);
+        for(tgui_u32 i = 0; i < tgui_array_size(&font->glyphs); ++i) {
+            font_set_glyph(font, tgui_array_get_ptr(&font->glyphs, i));
+        }
+    }
+    tgui_os_font_get_vmetrics(font->font, &font->ascent, &font->descent, &font->line_gap);
 
-        tgui_texture_atlas_add_bitmap(state.default_texture_atlas, &glyph->bitmap);
+    font->has_kerning = tgui_os_font_has_kerning(font->font);
+    if(font->has_kerning) {
+        tgui_virtual_map_initialize(&font->kerning_map);
+        font->kerning_table = tgui_arena_push_array(font_registry.arena, tgui_s16, TGUI_FONT_KERNING_COUNT*TGUI_FONT_KERNING_COUNT, 8);
+        for(tgui_u32 codepoint0 = TGUI_FONT_KERNING_FIRST; codepoint0 <= TGUI_FONT_KERNING_LAST; ++codepoint0) {
+            tgui_s16 *row = font->kerning_table + (codepoint0 - TGUI_FONT_KERNING_FIRST) * TGUI_FONT_KERNING_COUNT;
+            for(tgui_u32 codepoint1 = TGUI_FONT_KERNING_FIRST; codepoint1 <= TGUI_FONT_KERNING_LAST; ++codepoint1) {
+                row[codepoint1 - TGUI_FONT_KERNING_FIRST] = (tgui_s16)tgui_os_font_get_kerning_between(font->font, codepoint0, codepoint1);
+            }
+        }
     }
+
+    /* NOTE: The printable ascii glyphs are loaded up front, the rest when they are used */
+    tgui_u32 printable_codepoints[TGUI_FONT_PRINTABLE_COUNT];
+    for(tgui_u32 i = 0; i < TGUI_FONT_PRINTABLE_COUNT; ++i) {
+        printable_codepoints[i] = TGUI_FONT_PRINTABLE_FIRST + i;
+    }
+    font_load_glyphs(font, printable_codepoints, TGUI_FONT_PRINTABLE_COUNT);
+
+    TGuiGlyph *default_glyph = font_get_glyph(font, ' '); 
+    font->max_glyph_width  = default_glyph->adv_width;
+    font->max_glyph_height = font->ascent - font->descent + font->line_gap;
+
+    return handle;
+}
+
+void tgui_font_initilize(TGuiArena *arena) {
     
-    font.font = os_font;
+    font_registry.arena = arena;
+    tgui_array_initialize(&font_registry.faces);
+    tgui_array_initialize(&font_registry.fonts);
+
+    TGuiTextCache *text_cache = &font_registry.text_cache;
+    tgui_u32 entries_count = TGUI_TEXT_CACHE_SETS * TGUI_TEXT_CACHE_WAYS;
+    text_cache->entries = tgui_arena_push_array(arena, TGuiTextCacheEntry, entries_count, 8);
+    memset(text_cache->entries, 0, entries_count * sizeof(TGuiTextCacheEntry));
+    text_cache->use_counter = 0;
+    tgui_array_initialize(&text_cache->scratch_advances);
+    tgui_array_initialize(&font_registry.raster_jobs);
+    tgui_array_initialize(&font_registry.glyph_run);
 
-    TGuiGlyph *default_glyph = font.glyphs + get_codepoint_index(' '); 
-    font.max_glyph_width  = default_glyph->adv_width;
-    font.max_glyph_height = font.ascent - font.descent + font.line_gap;
+    glyph_cache_load();
+
+    TGuiFontFaceHandle face = font_face_create("/usr/share/fonts/truetype/liberation2/LiberationMono-Regular.ttf");
+    //TGuiFontFaceHandle face = font_face_create("/usr/share/fonts/truetype/noto/NotoSansMono-Regular.ttf");
+    TGUI_ASSERT(tgui_array_size(&font_registry.faces) == 1 && face == TGUI_DEFAULT_FONT_FACE);
+    
+    TGuiFontHandle font = font_create(face, TGUI_DEFAULT_FONT_SIZE, false);
+    TGUI_ASSERT(font == TGUI_DEFAULT_FONT);
+    TGUI_UNUSED(font);
 
+    state.current_font = TGUI_DEFAULT_FONT;
 }
 
 void tgui_font_terminate(void) {
-    tgui_os_font_destroy(font.font);
+    
+    glyph_cache_save();
+    glyph_cache_terminate();
+
+    for(tgui_u32 i = 0; i < tgui_array_size(&font_registry.fonts); ++i) {
+        TGuiFont *font = tgui_array_get_ptr(&font_registry.fonts, i);
+        tgui_virtual_map_terminate(&font->glyph_map);
+        tgui_array_terminate(&font->glyphs);
+        if(font->has_kerning) {
+            tgui_virtual_map_terminate(&font->kerning_map);
+        }
+        tgui_os_font_destroy(font->font);
+    }
+
+    for(tgui_u32 i = 0; i < tgui_array_size(&font_registry.faces); ++i) {
+        TGuiFontFace *face = tgui_array_get_ptr(&font_registry.faces, i);
+        if(face->sdf_font) {
+            tgui_virtual_map_terminate(&face->sdf_glyph_map);
+            tgui_array_terminate(&face->sdf_glyphs);
+            tgui_os_font_destroy(face->sdf_font);
+        }
+        tgui_os_font_destroy(face->font);
+    }
+
+    tgui_array_terminate(&font_registry.glyph_run);
+    tgui_array_terminate(&font_registry.raster_jobs);
+    tgui_array_terminate(&font_registry.text_cache.scratch_advances);
+    tgui_array_terminate(&font_registry.fonts);
+    tgui_array_terminate(&font_registry.faces);
 }
 
-TGuiGlyph *tgui_font_get_codepoint_glyph(tgui_u32 codepoint) {
-    return font.glyphs + get_codepoint_index(codepoint);
+TGuiFontFaceHandle tgui_font_load_face(char *path) {
+    return font_face_create(path);
 }
 
-TGuiRectangle tgui_get_size_text_dim(tgui_s32 x, tgui_s32 y, char *text, tgui_u32 size) {
-    TGuiRectangle result;
+static TGuiFontHandle font_find_or_create(TGuiFontFaceHandle face, tgui_u32 pixel_size, tgui_b32 sdf) {
     
-    tgui_s32 w = 0;
-    tgui_s32 h = font.max_glyph_height;
+    TGUI_ASSERT(face < tgui_array_size(&font_registry.faces));
+    TGUI_ASSERT(pixel_size > 0);
 
-    tgui_u32 text_len = size;
-    for(tgui_u32 i = 0; i < text_len; ++i) {
-        TGuiGlyph *glyph = font.glyphs + get_codepoint_index(text[i]);
-        w += glyph->adv_width;
+    for(tgui_u32 i = 0; i < tgui_array_size(&font_registry.fonts); ++i) {
+        TGuiFont *font = tgui_array_get_ptr(&font_registry.fonts, i);
+        if(font->face == face && font->size == pixel_size && font->sdf == sdf) {
+            return i;
+        }
     }
 
+    return font_create(face, pixel_size, sdf);
+}
+
+TGuiFontHandle tgui_font_get(TGuiFontFaceHandle face, tgui_u32 pixel_size) {
+    return font_find_or_create(face, pixel_size, false);
+}
+
+TGuiFontHandle tgui_font_get_sdf(TGuiFontFaceHandle face, tgui_u32 pixel_size) {
+    return font_find_or_create(face, pixel_size, true);
+}
+
+TGuiFont *tgui_font_get_from_handle(TGuiFontHandle font) {
+    TGUI_ASSERT(font < tgui_array_size(&font_registry.fonts));
+    return tgui_array_get_ptr(&font_registry.fonts, font);
+}
+
+void tgui_set_font(TGuiFontHandle font) {
+    TGUI_ASSERT(font < tgui_array_size(&font_registry.fonts));
+    state.current_font = font;
+}
+
+TGuiGlyph *tgui_font_get_codepoint_glyph(TGuiFontHandle font, tgui_u32 codepoint) {
+    return font_get_glyph(tgui_font_get_from_handle(font), codepoint);
+}
+
+void tgui_font_load_glyphs(TGuiFontHandle font, tgui_u32 *codepoints, tgui_u32 count) {
+    font_load_glyphs(tgui_font_get_from_handle(font), codepoints, count);
+}
+
+/* NOTE: advances must have space for size + 1 values, returns the number of codepoints */
+static tgui_u32 font_measure_text(TGuiFont *font, char *text, tgui_u32 size, tgui_s32 *advances) {
+    
+    tgui_s32 cursor = 0;
+    tgui_u32 codepoints_count = 0;
+    TGuiGlyph *last_glyph = NULL;
+    
+    for(tgui_u32 i = 0; i < size;) {
+        tgui_u32 codepoint;
+        i += tgui_utf8_decode(text + i, size - i, &codepoint);
+        TGuiGlyph *glyph = font_get_glyph(font, codepoint);
+        if(last_glyph) {
+            cursor += font_get_kerning(font, last_glyph->codepoint, glyph->codepoint);
+        }
+        advances[codepoints_count++] = cursor;
+        cursor += glyph->adv_width;
+        last_glyph = glyph;
+    }
+    advances[codepoints_count] = cursor;
+
+    return codepoints_count;
+}
+
+static TGuiTextCacheEntry *text_cache_find_or_add(TGuiTextCache *text_cache, TGuiFontHandle font_handle, char *text, tgui_u32 size) {
+
+    TGUI_ASSERT(size <= TGUI_TEXT_CACHE_MAX_SIZE);
+
+    tgui_u64 hash = tgui_hash_seed(text, size, (tgui_u64)font_handle + 1);
+    TGuiTextCacheEntry *set = text_cache->entries + (hash & (TGUI_TEXT_CACHE_SETS - 1)) * TGUI_TEXT_CACHE_WAYS;
+    
+    TGuiTextCacheEntry *victim = set;
+    for(tgui_u32 i = 0; i < TGUI_TEXT_CACHE_WAYS; ++i) {
+        TGuiTextCacheEntry *entry = set + i;
+        if(entry->used && entry->hash == hash && entry->font == font_handle &&
+           entry->size == size && memcmp(entry->text, text, size) == 0) {
+            entry->last_use = ++text_cache->use_counter;
+            return entry;
+        }
+        /* NOTE: Unused entries have last_use 0 so they are replaced first */
+        if(entry->last_use < victim->last_use) {
+            victim = entry;
+        }
+    }
+
+    victim->used = true;
+    victim->hash = hash;
+    victim->last_use = ++text_cache->use_counter;
+    victim->font = font_handle;
+    victim->size = size;
+    memcpy(victim->text, text, size);
+    victim->codepoints_count = font_measure_text(tgui_font_get_from_handle(font_handle), text, size, victim->advances);
+
+    return victim;
+}
+
+TGuiTextMetrics tgui_font_measure_text(TGuiFontHandle font_handle, char *text, tgui_u32 size) {
+    
+    TGuiTextMetrics result;
+    
+    TGuiFont *font = tgui_font_get_from_handle(font_handle);
+    TGuiTextCache *text_cache = &font_registry.text_cache;
+
+    if(size <= TGUI_TEXT_CACHE_MAX_SIZE) {
+        TGuiTextCacheEntry *entry = text_cache_find_or_add(text_cache, font_handle, text, size);
+        result.codepoints_count = entry->codepoints_count;
+        result.advances = entry->advances;
+    } else {
+        TGuiS32Array *scratch_advances = &text_cache->scratch_advances;
+        if(tgui_array_size(scratch_advances) < size + 1) {
+            tgui_array_reserve(scratch_advances, (size + 1) - tgui_array_size(scratch_advances));
+        }
+        result.advances = tgui_array_data(scratch_advances);
+        result.codepoints_count = font_measure_text(font, text, size, result.advances);
+    }
+
+    result.width = result.advances[result.codepoints_count];
+    result.height = font->max_glyph_height;
+
+    return result;
+}
+
+TGuiRectangle tgui_get_size_text_dim(TGuiFontHandle font, tgui_s32 x, tgui_s32 y, char *text, tgui_u32 size) {
+    TGuiRectangle result;
+    
+    TGuiTextMetrics metrics = tgui_font_measure_text(font, text, size);
+
     result.min_x = x;
     result.min_y = y;
-    result.max_x = result.min_x + w - 1;
-    result.max_y = result.min_y + h - 1;
+    result.max_x = result.min_x + metrics.width - 1;
+    result.max_y = result.min_y + metrics.height - 1;
 
     return result;
 }
 
-TGuiRectangle tgui_get_text_dim(tgui_s32 x, tgui_s32 y, char *text) {
-    return tgui_get_size_text_dim(x, y, text, strlen(text));
+TGuiRectangle tgui_get_text_dim(TGuiFontHandle font, tgui_s32 x, tgui_s32 y, char *text) {
+    return tgui_get_size_text_dim(font, x, y, text, strlen(text));
 }
 
-void tgui_font_draw_text(TGuiPainter *painter, tgui_s32 x, tgui_s32 y, char *text, tgui_u32 size, tgui_u32 color) {
+void tgui_font_draw_text(TGuiPainter *painter, TGuiFontHandle font_handle, tgui_s32 x, tgui_s32 y, char *text, tgui_u32 size, tgui_u32 color) {
+    
+    TGuiFont *font = tgui_font_get_from_handle(font_handle);
+
     tgui_s32 cursor = x;
-    tgui_s32 base   = y + font.ascent;
+    tgui_s32 base   = y + font->ascent;
+    TGuiGlyph *last_glyph = NULL;
+
+    /* NOTE: The coverage glyphs are collected and drawn with one glyph run */
+    TGuiGlyphRunItemArray *glyph_run = &font_registry.glyph_run;
+    tgui_array_clear(glyph_run);
 
     tgui_u32 text_len = size;
-    
-    tgui_u32 last_index = 0; TGUI_UNUSED(last_index);
-    for(tgui_u32 i = 0; i < text_len; ++i) {
+    for(tgui_u32 i = 0; i < text_len;) {
         
-        tgui_u32 index = get_codepoint_index(text[i]);
+        tgui_u32 codepoint;
+        i += tgui_utf8_decode(text + i, text_len - i, &codepoint);
 
-        TGuiGlyph *glyph = font.glyphs + index;
-        tgui_painter_draw_bitmap(painter, cursor + glyph->left_bearing, base - glyph->top_bearing, &glyph->bitmap, color);
+        TGuiGlyph *glyph = font_get_glyph(font, codepoint);
+        if(last_glyph) {
+            cursor += font_get_kerning(font, last_glyph->codepoint, glyph->codepoint);
+        }
+        
+        if(font->sdf) {
+            if(!tgui_rect_invalid(glyph->dim)) {
+                TGuiRectangle rect;
+                rect.min_x = cursor + glyph->left_bearing;
+                rect.min_y = base - glyph->top_bearing;
+                rect.max_x = rect.min_x + (tgui_s32)floorf((tgui_f32)tgui_rect_width(glyph->dim) * font->sdf_scale + 0.5f) - 1;
+                rect.max_y = rect.min_y + (tgui_s32)floorf((tgui_f32)tgui_rect_height(glyph->dim) * font->sdf_scale + 0.5f) - 1;
+                tgui_painter_draw_glyph_sdf(painter, rect, state.sdf_glyph_atlas, glyph->dim, color);
+            }
+        } else {
+            if(!tgui_rect_invalid(glyph->dim)) {
+                TGuiGlyphRunItem *item = tgui_array_push(glyph_run);
+                item->x = cursor + glyph->left_bearing;
+                item->y = base - glyph->top_bearing;
+                item->dim = glyph->dim;
+            }
+        }
+        
         cursor += glyph->adv_width;
+        last_glyph = glyph;
+    }
 
-        last_index = index;
+    if(tgui_array_size(glyph_run) > 0) {
+        tgui_painter_draw_glyph_run(painter, state.glyph_atlas, tgui_array_data(glyph_run), tgui_array_size(glyph_run), color);
     }
 }
 
@@ -193,10 +995,13 @@ void tgui_font_draw_text(TGuiPainter *painter, tgui_s32 x, tgui_s32 y, char *tex
 
 void tgui_texture(TGuiWindowHandle handle, void *texture) {
     TGuiWindow *window = tgui_window_get_from_handle(handle);
+    /* NOTE: The software framebuffer has no textures, the host draws the window after tgui_end */
+    if(state.software_pixels) return;
     if(!tgui_rect_invalid(window->dim)) {
         TGuiRenderBuffer *render_buffer = tgui_render_state_push_render_buffer_custom(&state.render_state, state.default_program, texture, NULL);
+        tgui_render_buffer_set_program_instanced(render_buffer, state.default_program_instanced);
         TGuiPainter painter;
-        tgui_painter_start(&painter, TGUI_PAINTER_TYPE_HARDWARE, window->dim, 0, NULL, render_buffer);
+        tgui_painter_start(&painter, state.hardware_painter_type, window->dim, 0, NULL, render_buffer);
         tgui_painter_draw_render_buffer_texture(&painter, window->dim);
     }
 }
@@ -330,11 +1135,12 @@ void tgui_calculate_hot_widget(TGuiWindow *window, TGuiRectangle rect, tgui_u64
     }
 }
 
-void tgui_widget_alloc_into_window(tgui_u64 id, TGuiWidgetInternalFunc internal, TGuiWindow *window, tgui_u32 x, tgui_u32 y, tgui_u32 w, tgui_u32 h) {
+TGuiWidget *tgui_widget_alloc_into_window(tgui_u64 id, TGuiWidgetInternalFunc internal, TGuiWindow *window, tgui_u32 x, tgui_u32 y, tgui_u32 w, tgui_u32 h) {
     
     TGuiWidget *widget = tgui_widget_alloc();
     
     widget->id = id;
+    widget->font = state.current_font;
     widget->parent = window;
     widget->x = x;
     widget->y = y;
@@ -346,6 +1152,8 @@ void tgui_widget_alloc_into_window(tgui_u64 id, TGuiWidgetInternalFunc internal,
     widget->internal = internal;
 
     tgui_clink_list_insert_back(window->widgets, widget);
+
+    return widget;
 }
 
 tgui_b32 _tgui_button(TGuiWindowHandle handle, char *label, tgui_s32 x, tgui_s32 y, char *tgui_id) {
@@ -410,11 +1218,11 @@ void _tgui_button_internal(TGuiWidget *widget, TGuiPainter *painter) {
     TGuiButton *button_state = tgui_widget_get_state(id, TGuiButton);
     
     char *label = button_state->label;
-    TGuiRectangle label_rect = tgui_get_text_dim(0, 0, label);
+    TGuiRectangle label_rect = tgui_get_text_dim(widget->font, 0, 0, label);
     
     tgui_s32 label_x = rect.min_x + (tgui_rect_width(rect) - 1) / 2 - (tgui_rect_width(label_rect) - 1) / 2;
     tgui_s32 label_y = rect.min_y + (tgui_rect_height(rect) - 1) / 2 - (tgui_rect_height(label_rect) - 1) / 2;
-    tgui_font_draw_text(painter, label_x, label_y, label,  strlen(label), decoration_color);
+    tgui_font_draw_text(painter, widget->font, label_x, label_y, label,  strlen(label), decoration_color);
     tgui_painter_draw_rectangle_outline(painter, rect, decoration_color);
 
     painter->clip = saved_painter_clip;
@@ -422,25 +1230,58 @@ void _tgui_button_internal(TGuiWidget *widget, TGuiPainter *painter) {
     button_state->result = result;
 }
 
-static TGuiRectangle calculate_selection_rect(TGuiTextInput *text_input, tgui_s32 x, tgui_s32 y, tgui_u32 start, tgui_u32 end) {
+/* NOTE: start and end are codepoint indices, x is the position of the codepoint at the offset */
+static TGuiRectangle calculate_selection_rect(TGuiFont *font, TGuiTextMetrics *metrics, tgui_u32 offset, tgui_s32 x, tgui_s32 y, tgui_u32 start, tgui_u32 end) {
 
     if(start > end) {
         tgui_u32 temp = start;
         start = end;
         end = temp;
     }
-    TGUI_ASSERT(start <= end);
+    TGUI_ASSERT(start <= end && end <= metrics->codepoints_count);
 
     TGuiRectangle result = {
-        x + (start - text_input->offset) * font.max_glyph_width,
+        x + metrics->advances[start] - metrics->advances[offset],
         y,
-        x + (end - text_input->offset) * font.max_glyph_width,
-        y + font.max_glyph_height,
+        x + metrics->advances[end] - metrics->advances[offset],
+        y + font->max_glyph_height,
     };
 
     return result;
 }
 
+/* NOTE: The cursor, the offset and the selection are byte indices that are always at the start of
+   a codepoint, they move over whole codepoints as tgui_utf8_decode reads them */
+static tgui_u32 text_input_next_codepoint(TGuiTextInput *text_input, tgui_u32 index) {
+    if(index >= text_input->used) return text_input->used;
+    tgui_u32 codepoint;
+    return index + tgui_utf8_decode((char *)text_input->buffer + index, text_input->used - index, &codepoint);
+}
+
+static tgui_u32 text_input_prev_codepoint(TGuiTextInput *text_input, tgui_u32 index) {
+    if(index == 0) return 0;
+    
+    tgui_u32 start = index - 1;
+    while(start > 0 && (index - start) < 4 && (text_input->buffer[start] & 0xc0) == 0x80) {
+        --start;
+    }
+    
+    /* NOTE: Invalid sequences are decoded one byte at a time */
+    tgui_u32 codepoint;
+    if(start + tgui_utf8_decode((char *)text_input->buffer + start, text_input->used - start, &codepoint) == index) {
+        return start;
+    }
+    return index - 1;
+}
+
+static tgui_u32 text_input_codepoint_index(TGuiTextInput *text_input, tgui_u32 index) {
+    tgui_u32 result = 0;
+    for(tgui_u32 i = 0; i < index; i = text_input_next_codepoint(text_input, i)) {
+        ++result;
+    }
+    return result;
+}
+
 static void delete_selection(TGuiTextInput *text_input) {
     
     tgui_u32 start = text_input->selection_start;
@@ -499,6 +1340,7 @@ void _tgui_text_input_internal(TGuiWidget *widget, TGuiPainter *painter) {
     tgui_calculate_hot_widget(window, rect, id);
     
     TGuiTextInput *text_input = tgui_widget_get_state(id, TGuiTextInput);
+    TGuiFont *font = tgui_font_get_from_handle(widget->font);
     
     if(!text_input->initilize) {
         
@@ -531,7 +1373,7 @@ void _tgui_text_input_internal(TGuiWidget *widget, TGuiPainter *painter) {
 
     TGuiRectangle visible_rect = tgui_rect_intersection(rect, window->dim);
     tgui_u32 padding_x = 8;
-    tgui_u32 visible_glyphs = TGUI_MAX((tgui_s32)((tgui_rect_width(visible_rect) - padding_x*2)/font.max_glyph_width), (tgui_s32)0);
+    tgui_s32 visible_width = TGUI_MAX(tgui_rect_width(visible_rect) - (tgui_s32)padding_x*2, 0);
 
     if(state.active == id) {
         
@@ -550,7 +1392,7 @@ void _tgui_text_input_internal(TGuiWidget *widget, TGuiPainter *painter) {
                 text_input->selection_start = text_input->cursor;
             }
 
-            text_input->cursor = TGUI_MIN(text_input->cursor + 1, text_input->used);
+            text_input->cursor = text_input_next_codepoint(text_input, text_input->cursor);
 
             /* NOTE: End selection */
             if(text_input->selection) {
@@ -573,7 +1415,7 @@ void _tgui_text_input_internal(TGuiWidget *widget, TGuiPainter *painter) {
                 text_input->selection_start = text_input->cursor;
             }
             
-            text_input->cursor = TGUI_MAX((tgui_s32)text_input->cursor - 1, 0);
+            text_input->cursor = text_input_prev_codepoint(text_input, text_input->cursor);
 
             /* NOTE: End selection */
             if(text_input->selection) {
@@ -591,11 +1433,16 @@ void _tgui_text_input_internal(TGuiWidget *widget, TGuiPainter *painter) {
             if(text_input->selection) {
                 delete_selection(text_input);
             } else if(text_input->cursor > 0) {
-                memmove(text_input->buffer + text_input->cursor - 1,
+                tgui_u32 start = text_input_prev_codepoint(text_input, text_input->cursor);
+                tgui_u32 size = text_input->cursor - start;
+                memmove(text_input->buffer + start,
                         text_input->buffer + text_input->cursor,
                         text_input->used - text_input->cursor);
-                text_input->cursor -= 1;
-                text_input->used   -= 1;
+                text_input->cursor -= size;
+                text_input->used   -= size;
+                if(text_input->offset > text_input->cursor) {
+                    text_input->offset = text_input->cursor;
+                }
             }
         
         } else if(keyboard->k_delete) {
@@ -608,10 +1455,11 @@ void _tgui_text_input_internal(TGuiWidget *widget, TGuiPainter *painter) {
             if(text_input->selection) {
                 delete_selection(text_input);
             } else if(text_input->cursor < text_input->used) {
+                tgui_u32 end = text_input_next_codepoint(text_input, text_input->cursor);
                 memmove(text_input->buffer + text_input->cursor,
-                        text_input->buffer + text_input->cursor + 1,
-                        text_input->used - text_input->cursor - 1);
-                text_input->used -= 1;
+                        text_input->buffer + end,
+                        text_input->used - end);
+                text_input->used -= (end - text_input->cursor);
             }
 
         } else if(input.text_size > 0) {
@@ -625,25 +1473,36 @@ void _tgui_text_input_internal(TGuiWidget *widget, TGuiPainter *painter) {
                 delete_selection(text_input);
             }
 
-            if((text_input->used + input.text_size) > TGUI_TEXT_INPUT_MAX_CHARACTERS) {
-                input.text_size = (TGUI_TEXT_INPUT_MAX_CHARACTERS - text_input->used);
-                TGUI_ASSERT((text_input->used + input.text_size) == TGUI_TEXT_INPUT_MAX_CHARACTERS);
+            /* NOTE: The text that does not fit is cut at the start of a codepoint */
+            tgui_u32 text_size = input.text_size;
+            if((text_input->used + text_size) > TGUI_TEXT_INPUT_MAX_CHARACTERS) {
+                text_size = (TGUI_TEXT_INPUT_MAX_CHARACTERS - text_input->used);
+                while(text_size > 0 && (input.text[text_size] & 0xc0) == 0x80) {
+                    --text_size;
+                }
+                TGUI_ASSERT((text_input->used + text_size) <= TGUI_TEXT_INPUT_MAX_CHARACTERS);
             }
 
-            memmove(text_input->buffer + text_input->cursor + input.text_size, 
+            memmove(text_input->buffer + text_input->cursor + text_size, 
                     text_input->buffer + text_input->cursor, 
                     (text_input->used - text_input->cursor));
-            memcpy(text_input->buffer + text_input->cursor, input.text, input.text_size);
+            memcpy(text_input->buffer + text_input->cursor, input.text, text_size);
 
-            text_input->used   += input.text_size;
-            text_input->cursor += input.text_size;
+            text_input->used   += text_size;
+            text_input->cursor += text_size;
         }
         
-        /* Calculate the ofset of the text */
-        if(text_input->cursor > text_input->offset + visible_glyphs) {
-            text_input->offset += 1;
-        } else if(text_input->offset > 0 && text_input->cursor < text_input->offset) {
-            text_input->offset -= 1;
+        /* NOTE: Scroll the text until the cursor is visible */
+        if(text_input->cursor < text_input->offset) {
+            text_input->offset = text_input->cursor;
+        } else {
+            TGuiTextMetrics metrics = tgui_font_measure_text(widget->font, (char *)text_input->buffer, text_input->used);
+            tgui_u32 cursor_index = text_input_codepoint_index(text_input, text_input->cursor);
+            tgui_u32 offset_index = text_input_codepoint_index(text_input, text_input->offset);
+            while(offset_index < cursor_index && metrics.advances[cursor_index] - metrics.advances[offset_index] > visible_width) {
+                text_input->offset = text_input_next_codepoint(text_input, text_input->offset);
+                ++offset_index;
+            }
         }
     
     } else if(state.hot == id) {
@@ -684,23 +1543,33 @@ void _tgui_text_input_internal(TGuiWidget *widget, TGuiPainter *painter) {
     painter->clip = tgui_rect_intersection(clipping_rect, painter->clip);
     
     tgui_s32 text_x = rect.min_x + padding_x;
-    tgui_s32 text_y = rect.min_y + ((tgui_rect_height(rect) - 1) / 2) - ((font.max_glyph_height - 1) / 2);
+    tgui_s32 text_y = rect.min_y + ((tgui_rect_height(rect) - 1) / 2) - ((font->max_glyph_height - 1) / 2);
     
 
+    /* NOTE: The selection and the cursor are placed with the advances of the codepoints so the
+       font does not have to be monospace. The text is drawn from its start moved left by the
+       advance of the offset, so the kerning of the first visible glyph is the same as in the
+       advances */
+    TGuiTextMetrics metrics = tgui_font_measure_text(widget->font, (char *)text_input->buffer, text_input->used);
+    tgui_u32 offset_index = text_input_codepoint_index(text_input, text_input->offset);
+
     if(text_input->selection) {
-        TGuiRectangle selection_rect = calculate_selection_rect(text_input, text_x, text_y, text_input->selection_start, text_input->selection_end);
+        tgui_u32 selection_start = text_input_codepoint_index(text_input, text_input->selection_start);
+        tgui_u32 selection_end = text_input_codepoint_index(text_input, text_input->selection_end);
+        TGuiRectangle selection_rect = calculate_selection_rect(font, &metrics, offset_index, text_x, text_y, selection_start, selection_end);
         tgui_painter_draw_rectangle(painter, selection_rect, 0x7777ff);
     }
 
-    tgui_font_draw_text(painter, text_x, text_y, (char *)text_input->buffer + text_input->offset,
-            text_input->used - text_input->offset, decoration_color);
+    tgui_font_draw_text(painter, widget->font, text_x - metrics.advances[offset_index], text_y, (char *)text_input->buffer,
+            text_input->used, decoration_color);
 
     if(state.active == id && text_input->draw_cursor) {
+        tgui_s32 cursor_x = text_x + metrics.advances[text_input_codepoint_index(text_input, text_input->cursor)] - metrics.advances[offset_index];
         TGuiRectangle cursor_rect = {
-            text_x + ((text_input->cursor - text_input->offset) * font.max_glyph_width),
+            cursor_x,
             text_y,
-            text_x + ((text_input->cursor - text_input->offset) * font.max_glyph_width),
-            text_y + font.max_glyph_height,
+            cursor_x,
+            text_y + font->max_glyph_height,
         };
         tgui_painter_draw_rectangle(painter, cursor_rect, cursor_color);
     }
@@ -1031,6 +1900,7 @@ void _tgui_tree_view_begin(TGuiWindowHandle handle, char *tgui_id) {
     
     TGuiTreeView *treeview = tgui_widget_get_state(state.active_id, TGuiTreeView);
     treeview->dim = (TGuiRectangle){ 0, 0, 0, 0 };
+    treeview->font = state.current_font;
 
     if(!treeview->initiliaze) {
 
@@ -1080,7 +1950,8 @@ void _tgui_tree_view_end(void **selected_data) {
     tgui_s32 w = tgui_rect_width(treeview->dim);
     tgui_s32 h = tgui_rect_height(treeview->dim);
 
-    tgui_widget_alloc_into_window(state.active_id, _tgui_tree_view_internal, state.active_window, x, y, w, h);
+    TGuiWidget *widget = tgui_widget_alloc_into_window(state.active_id, _tgui_tree_view_internal, state.active_window, x, y, w, h);
+    widget->font = treeview->font;
 
     state.active_window = NULL;
     state.active_id = -1;
@@ -1118,7 +1989,7 @@ void treeview_node_setup(TGuiTreeView *treeview, TGuiTreeViewNode *node, char *l
         tgui_u32 depth_in_pixels = depth*TGUI_TREEVIEW_DEFAULT_DEPTH_WIDTH;
         tgui_u32 x = treeview->padding*2 + treeview->rect_w + depth_in_pixels;
         
-        TGuiRectangle text_label = tgui_get_text_dim(x, treeview->dim.max_y+1, label);
+        TGuiRectangle text_label = tgui_get_text_dim(treeview->font, x, treeview->dim.max_y+1, label);
         treeview->dim = tgui_rect_union(treeview->dim, text_label);
 
         node->dim = text_label;
@@ -1244,7 +2115,7 @@ void treeview_node_draw(TGuiWidget *widget, TGuiTreeView *treeview, TGuiTreeView
 
 
     tgui_s32 label_x = node->dim.min_x + treeview->rect_w/2;
-    tgui_font_draw_text(painter, label_x+rect_w+padding, node->dim.min_y, node->label, strlen(node->label), 0x333333);
+    tgui_font_draw_text(painter, widget->font, label_x+rect_w+padding, node->dim.min_y, node->label, strlen(node->label), 0x333333);
 
     for(tgui_u32 i = 0; i < node->label_depth; ++i) {
         tgui_u32 depth_in_pixel = TGUI_TREEVIEW_DEFAULT_DEPTH_WIDTH * ((node->label_depth-1) - i);
@@ -1497,7 +2368,7 @@ void _tgui_dropdown_menu_internal(TGuiWidget *widget, TGuiPainter *painter) {
             TGuiRectangle option_rect = calculate_option_rect(rect.min_x, rect.min_y, i);
 
             char *label = dropdown->options[i];
-            TGuiRectangle label_rect = tgui_get_text_dim(0, 0, label);
+            TGuiRectangle label_rect = tgui_get_text_dim(widget->font, 0, 0, label);
             
             tgui_s32 label_x = option_rect.min_x + (tgui_rect_width(option_rect) - 1) / 2 - (tgui_rect_width(label_rect) - 1) / 2;
             tgui_s32 label_y = option_rect.min_y + (tgui_rect_height(option_rect) - 1) / 2 - (tgui_rect_height(label_rect) - 1) / 2;
@@ -1508,7 +2379,7 @@ void _tgui_dropdown_menu_internal(TGuiWidget *widget, TGuiPainter *painter) {
             }
             tgui_painter_draw_rectangle(painter, option_rect, color);
             tgui_painter_draw_hline(painter, option_rect.max_y, option_rect.min_x, option_rect.max_x, 0x777777);
-            tgui_font_draw_text(painter, label_x, label_y, label, strlen(label), 0x444444);
+            tgui_font_draw_text(painter, widget->font, label_x, label_y, label, strlen(label), 0x444444);
         }
     }
     
@@ -1516,14 +2387,14 @@ void _tgui_dropdown_menu_internal(TGuiWidget *widget, TGuiPainter *painter) {
 
     TGuiRectangle option_rect = header_rect;
     char *label = dropdown->options[dropdown->selected_option];
-    TGuiRectangle label_rect = tgui_get_text_dim(0, 0, label);
+    TGuiRectangle label_rect = tgui_get_text_dim(widget->font, 0, 0, label);
 
     tgui_s32 label_x = option_rect.min_x + (tgui_rect_width(option_rect) - 1) / 2 - (tgui_rect_width(label_rect) - 1) / 2 - cruz_w;
     tgui_s32 label_y = option_rect.min_y + (tgui_rect_height(option_rect) - 1) / 2 - (tgui_rect_height(label_rect) - 1) / 2;
 
     tgui_painter_draw_rectangle(painter, header_rect, 0x444444);
     tgui_painter_draw_rectangle_outline(painter, rect, 0x222222);
-    tgui_font_draw_text(painter, label_x, label_y, label, strlen(label), 0x999999);
+    tgui_font_draw_text(painter, widget->font, label_x, label_y, label, strlen(label), 0x999999);
 
     tgui_s32 cruz_x = rect.max_x - (cruz_w + 12);
     tgui_s32 cruz_y = option_rect.min_y + (tgui_rect_height(option_rect) - 1) / 2 - (cruz_w - 1) / 2;
@@ -1669,8 +2540,27 @@ void tgui_initialize(tgui_s32 window_w, tgui_s32 window_h, TGuiGfxBackend *gfx)
     state.default_texture_atlas = tgui_arena_push_struct(&state.arena, TGuiTextureAtlas, 8);
     tgui_texture_atlas_initialize(state.default_texture_atlas);
 
+    state.glyph_atlas = tgui_arena_push_struct(&state.arena, TGuiGlyphAtlas, 8);
+    tgui_glyph_atlas_initialize(state.glyph_atlas);
+    
+    state.sdf_glyph_atlas = tgui_arena_push_struct(&state.arena, TGuiGlyphAtlas, 8);
+    tgui_glyph_atlas_initialize(state.sdf_glyph_atlas);
+
     state.default_program = gfx->create_program("./shaders/quad.vert", "./shaders/quad.frag");
 
+    state.sdf_program = gfx->create_program("./shaders/quad.vert", "./shaders/quad_sdf.frag");
+
+    state.default_program_instanced = NULL;
+    state.sdf_program_instanced = NULL;
+    state.hardware_painter_type = TGUI_PAINTER_TYPE_HARDWARE;
+    if(gfx->draw_instances) {
+        state.default_program_instanced = gfx->create_program("./shaders/quad_instanced.vert", "./shaders/quad.frag");
+        state.sdf_program_instanced = gfx->create_program("./shaders/quad_instanced.vert", "./shaders/quad_sdf.frag");
+        state.hardware_painter_type = TGUI_PAINTER_TYPE_HARDWARE_INSTANCED;
+    }
+
+    tgui_tile_binner_initialize(&state.software_binner);
+
     tgui_font_initilize(&state.arena);
     tgui_docker_initialize();
 
@@ -1683,7 +2573,15 @@ void tgui_terminate(void) {
     tgui_docker_terminate();
     tgui_font_terminate();
 
+    if(state.default_texture) {
+        state.render_state.gfx->destroy_texture(state.default_texture);
+    }
+
+    tgui_glyph_atlas_terminate(state.glyph_atlas, state.render_state.gfx);
+    tgui_glyph_atlas_terminate(state.sdf_glyph_atlas, state.render_state.gfx);
+
     tgui_render_state_terminate(&state.render_state);
+    tgui_tile_binner_terminate(&state.software_binner);
 
     tgui_virtual_map_terminate(&state.registry);
     tgui_arena_terminate(&state.arena);
@@ -1761,7 +2659,7 @@ void tgui_free_allocated_windows_list(TGuiAllocatedWindow *list) {
 }
 
 void tgui_try_to_load_data_file(void) {
-    TGuiOsFile *file = tgui_os_file_read_entire("./tgui.dat");
+    TGuiOsFile *file = tgui_os_file_map("./tgui.dat", TGUI_OS_FILE_ACCESS_SEQUENTIAL);
     if(file) {
         TGuiAllocatedWindow allocated_windows;
         TGuiDockerNode *saved_root;
@@ -1787,6 +2685,7 @@ void tgui_try_to_load_data_file(void) {
 
 void tgui_begin(tgui_f32 dt) {
     state.dt = dt;
+    state.current_font = TGUI_DEFAULT_FONT;
 
     input.mouse_x = TGUI_CLAMP(input.mouse_x, 0, (input.resize_w-1));
     input.mouse_y = TGUI_CLAMP(input.mouse_y, 0, (input.resize_h-1));
@@ -1964,22 +2863,57 @@ void tgui_process_scroll_window(TGuiWindow *window, TGuiPainter *painter) {
     painter->clip = saved_painter_clip;
 }
 
+/* NOTE: Upload the changes of the atlases if glyphs or bitmaps were added to them, the render
+   buffers reference the textures so this has to run before they are drawn */
+static void tgui_update_textures(tgui_b32 allow_resize) {
+    
+    TGuiGfxBackend *gfx = state.render_state.gfx;
+    
+    if(tgui_glyph_atlas_update_texture(state.glyph_atlas, gfx, allow_resize)) {
+        tgui_invalidate_frame();
+    }
+    
+    if(tgui_glyph_atlas_update_texture(state.sdf_glyph_atlas, gfx, allow_resize)) {
+        tgui_invalidate_frame();
+    }
+
+    if(tgui_texture_atlas_update_texture(state.default_texture_atlas, gfx, allow_resize)) {
+        tgui_invalidate_frame();
+    }
+}
+
 void tgui_end(void) {
 
+    /* NOTE: The atlases that grew during the last frame are uploaded now, before any texture coordinate is pushed */
+    tgui_update_textures(true);
 
     TGuiRenderBuffer *render_buffer_tgui = &state.render_state.render_buffer_tgui;
     tgui_render_buffer_set_program(render_buffer_tgui, state.default_program);
+    tgui_render_buffer_set_program_instanced(render_buffer_tgui, state.default_program_instanced);
+    tgui_render_buffer_set_program_sdf(render_buffer_tgui, state.sdf_program);
+    tgui_render_buffer_set_program_sdf_instanced(render_buffer_tgui, state.sdf_program_instanced);
     tgui_render_buffer_set_texture(render_buffer_tgui, state.default_texture);
     tgui_render_buffer_set_texture_atlas(render_buffer_tgui, state.default_texture_atlas);
 
     TGuiRenderBuffer *render_buffer_tgui_on_top = &state.render_state.render_buffer_tgui_on_top;
     tgui_render_buffer_set_program(render_buffer_tgui_on_top, state.default_program);
+    tgui_render_buffer_set_program_instanced(render_buffer_tgui_on_top, state.default_program_instanced);
+    tgui_render_buffer_set_program_sdf(render_buffer_tgui_on_top, state.sdf_program);
+    tgui_render_buffer_set_program_sdf_instanced(render_buffer_tgui_on_top, state.sdf_program_instanced);
     tgui_render_buffer_set_texture(render_buffer_tgui_on_top, state.default_texture);
     tgui_render_buffer_set_texture_atlas(render_buffer_tgui_on_top, state.default_texture_atlas);
     
     if(docker.root != NULL) {
         TGuiPainter painter;
-        tgui_painter_start(&painter, TGUI_PAINTER_TYPE_HARDWARE, docker.root->dim, 0, NULL, render_buffer_tgui);
+        if(state.software_pixels) {
+            TGUI_ASSERT(tgui_rect_width(docker.root->dim) == (tgui_s32)state.software_width);
+            TGUI_ASSERT(tgui_rect_height(docker.root->dim) == (tgui_s32)state.software_height);
+            tgui_painter_start_binned(&painter, docker.root->dim, 0, state.software_pixels, &state.software_binner);
+            tgui_damage_clear(&state.software_damage);
+            tgui_painter_set_damage(&painter, &state.software_damage);
+        } else {
+            tgui_painter_start(&painter, state.hardware_painter_type, docker.root->dim, 0, NULL, render_buffer_tgui);
+        }
 
         tgui_docker_root_node_draw(&painter);
 
@@ -1998,16 +2932,75 @@ void tgui_end(void) {
         }
 
         tgui_docker_draw_preview(&painter);
+
+        tgui_painter_flush(&painter);
+    }
+
+    /* NOTE: If a glyph atlas has to grow the texture coordinates pushed this frame are for the
+       old size, so its new texture is uploaded on the next frame and the new glyphs appear then.
+       The pages added to the texture atlas do not move the textures so they are uploaded now, a
+       compacted texture atlas waits for the next frame like the glyph atlases */
+    tgui_texture_atlas_insert_pending(state.default_texture_atlas);
+    tgui_update_textures(false);
+
+    if(docker.root != NULL) {
+        tgui_u32 width = tgui_rect_width(docker.root->dim);
+        tgui_u32 height = tgui_rect_height(docker.root->dim);
+        tgui_render_state_update_frame_changed(&state.render_state, width, height);
     }
 
     input.mouse_button_was_down = input.mouse_button_is_down;
 }
 
+void tgui_set_software_framebuffer(tgui_u32 *pixels, tgui_u32 width, tgui_u32 height) {
+    state.software_pixels = pixels;
+    state.software_width = width;
+    state.software_height = height;
+    tgui_tile_binner_invalidate(&state.software_binner);
+}
+
+TGuiDamage *tgui_get_damage(void) {
+    return &state.software_damage;
+}
+
+tgui_b32 tgui_window_is_damaged(TGuiWindowHandle handle) {
+    if(!state.software_pixels) return true;
+    TGuiWindow *window = tgui_window_get_from_handle(handle);
+    return tgui_damage_overlaps(&state.software_damage, window->dim);
+}
+
+void tgui_set_skip_unchanged_frames(tgui_b32 enable) {
+    state.render_state.skip_unchanged_frames = enable;
+    tgui_invalidate_frame();
+}
+
+void tgui_invalidate_frame(void) {
+    state.render_state.frame_hash = 0;
+    state.render_state.frame_changed = true;
+    tgui_tile_binner_invalidate(&state.software_binner);
+}
+
+tgui_b32 tgui_frame_changed(void) {
+    return state.render_state.frame_changed;
+}
+
 void tgui_draw_buffers(void) {
+
+    if(!tgui_frame_changed()) {
+        /* NOTE: The last presented image is still valid, nothing to submit */
+        tgui_render_state_clear_render_buffers(&state.render_state);
+        return;
+    }
+
     tgui_u32 width = tgui_rect_width(docker.root->dim);
     tgui_u32 height = tgui_rect_height(docker.root->dim);
 
     state.render_state.gfx->set_program_width_and_height(state.default_program, width, height);
+    state.render_state.gfx->set_program_width_and_height(state.sdf_program, width, height);
+    if(state.default_program_instanced) {
+        state.render_state.gfx->set_program_width_and_height(state.default_program_instanced, width, height);
+        state.render_state.gfx->set_program_width_and_height(state.sdf_program_instanced, width, height);
+    }
     tgui_render_state_draw_buffers(&state.render_state);
     tgui_render_state_clear_render_buffers(&state.render_state);
 
@@ -110,10 +110,16 @@ void tgui_window_flag_clear(TGuiWindow *window, TGuiWindowFlags flag);
 
 typedef void (*TGuiWidgetInternalFunc) (struct TGuiWidget *widget, TGuiPainter *painter);
 
+typedef tgui_u32 TGuiFontFaceHandle;
+typedef tgui_u32 TGuiFontHandle;
+
 typedef struct TGuiWidget {
     tgui_u64 id;
     tgui_s32 x, y, w, h;    
 
+    /* NOTE: Font selected with tgui_set_font when the widget was created */
+    TGuiFontHandle font;
+
     struct TGuiWindow *parent;
     struct TGuiWidget *prev;
     struct TGuiWidget *next;
@@ -160,7 +166,22 @@ typedef struct TGui {
     
     void *default_texture;
     void *default_program;
+    void *default_program_instanced;
+    TGuiPainterType hardware_painter_type;
     TGuiTextureAtlas *default_texture_atlas;
+    TGuiGlyphAtlas *glyph_atlas;
+    
+    TGuiGlyphAtlas *sdf_glyph_atlas;
+    void *sdf_program;
+    void *sdf_program_instanced;
+
+    TGuiFontHandle current_font;
+
+    /* NOTE: Set with tgui_set_software_framebuffer, the frame is drawn by the binned software painter */
+    tgui_u32 *software_pixels;
+    tgui_u32 software_width, software_height;
+    TGuiTileBinner software_binner;
+    TGuiDamage software_damage;
 
 } TGui;
 
@@ -174,6 +195,33 @@ void tgui_end(void);
 
 void tgui_draw_buffers(void);
 
+/* NOTE: With a framebuffer tgui_end draws the frame into pixels with the binned software painter,
+   the tiles are rasterized in parallel and tgui_draw_buffers is not needed. The framebuffer has the
+   size of the root window, the windows of tgui_texture are left for the host. NULL goes back to
+   the render buffers of the gfx backend.
+   Only the tiles that changed since the last frame are rasterized, the rest of the framebuffer
+   has to keep the last frame. Content of bitmaps is not tracked, call tgui_invalidate_frame when
+   it changes */
+void tgui_set_software_framebuffer(tgui_u32 *pixels, tgui_u32 width, tgui_u32 height);
+
+/* NOTE: Region of the software framebuffer rasterized by the last tgui_end, the host presents only
+   the damaged rows */
+TGuiDamage *tgui_get_damage(void);
+
+/* NOTE: True if the last tgui_end rasterized over the window, the host draws the windows of
+   tgui_texture again only when they are damaged. Always true without software framebuffer */
+tgui_b32 tgui_window_is_damaged(TGuiWindowHandle window);
+
+/* NOTE: When enable, tgui_end compares the geometry of the frame with the last one and
+   tgui_draw_buffers submits nothing if it did not change, the host can check
+   tgui_frame_changed after tgui_end to skip its clear and swap. Content of custom textures
+   is not tracked, call tgui_invalidate_frame when it changes or the window is exposed */
+void tgui_set_skip_unchanged_frames(tgui_b32 enable);
+
+void tgui_invalidate_frame(void);
+
+tgui_b32 tgui_frame_changed(void);
+
 void tgui_try_to_load_data_file(void);
 
 void tgui_free_allocated_windows_list(struct TGuiAllocatedWindow *list);
@@ -182,6 +230,10 @@ TGuiInput *tgui_get_input(void);
 
 TGuiCursor tgui_get_cursor_state(void);
 
+tgui_u64 tgui_hash(void *bytes, tgui_u64 size);
+
+tgui_u64 tgui_hash_seed(void *bytes, tgui_u64 size, tgui_u64 seed);
+
 #define tgui_safe_dereference(ptr, type) (((ptr) == NULL) ? (type){0} : *((type *)ptr))
 
 /* --------------------------- */
@@ -336,6 +388,9 @@ typedef struct TGuiTreeView {
     tgui_s32 selection_index;
     void *selection_data;
 
+    /* NOTE: Font of the widget, set in begin so the labels are measured and drawn with the same font */
+    TGuiFontHandle font;
+
 } TGuiTreeView;
 
 void _tgui_tree_view_begin(TGuiWindowHandle window, char *tgui_id);
@@ -374,7 +429,8 @@ void _tgui_dropdown_menu_internal(TGuiWidget *widget, TGuiPainter *painter);
 /* ---------------------- */
 
 typedef struct TGuiGlyph {
-    TGuiBitmap bitmap;
+    /* NOTE: Coverage of the glyph in the glyph atlas, invalid for empty glyphs */
+    TGuiRectangle dim;
     tgui_s32 codepoint;
 
     tgui_s32 top_bearing;
@@ -383,12 +439,79 @@ typedef struct TGuiGlyph {
 
 } TGuiGlyph;
 
+TGuiArray(TGuiGlyph, TGuiGlyphArray);
+
+/* NOTE: Rasterization of one glyph that can run in a worker thread, the buffer is allocated by the
+   rasterizer and freed when the glyph is inserted in the atlas in the calling thread */
+typedef struct TGuiGlyphRasterJob {
+    struct TGuiOsFont *font;
+    tgui_b32 sdf;
+    tgui_u32 codepoint;
+
+    void *buffer;
+    tgui_s32 w, h;
+    tgui_s32 x_offset, y_offset;
+    /* NOTE: Set by the job, a finished job without buffer is an empty glyph */
+    tgui_b32 finished;
+} TGuiGlyphRasterJob;
+
+TGuiArray(TGuiGlyphRasterJob, TGuiGlyphRasterJobArray);
+
+/* NOTE: A face is a font file loaded once, every size requested from it is a TGuiFont that
+   shares the file of the face and rasterizes its glyphs into the glyph atlas the first time
+   they are used. Handles are indices in the registry, the default face and font are 0 */
+
+#define TGUI_DEFAULT_FONT_FACE 0
+#define TGUI_DEFAULT_FONT 0
+#define TGUI_DEFAULT_FONT_SIZE 18
+#define TGUI_FONT_ASCII_GLYPHS 128
+
+/* NOTE: Glyphs of printable ASCII, loaded when the font is created */
+#define TGUI_FONT_PRINTABLE_FIRST 32
+#define TGUI_FONT_PRINTABLE_LAST 126
+#define TGUI_FONT_PRINTABLE_COUNT (TGUI_FONT_PRINTABLE_LAST - TGUI_FONT_PRINTABLE_FIRST + 1)
+
+/* NOTE: Signed distance field fonts of a face share one set of glyphs rasterized at
+   TGUI_FONT_SDF_SIZE in the sdf glyph atlas, every size scales them when they are drawn */
+
+#define TGUI_FONT_SDF_SIZE 32
+
+/* NOTE: The kerning of the pairs of printable ASCII is computed when the font is created in a
+   dense table, the kerning of the other pairs is computed the first time is used and kept in
+   kerning_map. Fonts without kerning information have no table */
+
+#define TGUI_FONT_KERNING_FIRST 32
+#define TGUI_FONT_KERNING_LAST 126
+#define TGUI_FONT_KERNING_COUNT (TGUI_FONT_KERNING_LAST - TGUI_FONT_KERNING_FIRST + 1)
+
+typedef struct TGuiFontFace {
+    /* NOTE: Own the font file, it is not used to rasterize */
+    struct TGuiOsFont *font;
+    tgui_u64 file_hash;
+
+    /* NOTE: Created with the first sdf font of the face, the glyph bearings are the
+       offsets of the field at TGUI_FONT_SDF_SIZE */
+    struct TGuiOsFont *sdf_font;
+    TGuiVirtualMap sdf_glyph_map;
+    TGuiGlyphArray sdf_glyphs;
+} TGuiFontFace;
+
 typedef struct TGuiFont {
-    TGuiGlyph *glyphs;
+    TGuiFontFaceHandle face;
+    tgui_u32 size;
     
-    tgui_u32 glyph_count;
-    tgui_u32 glyph_rage_start;
-    tgui_u32 glyph_rage_end;
+    /* NOTE: The glyph dim of sdf fonts is in the sdf glyph atlas and sdf_scale times bigger on screen */
+    tgui_b32 sdf;
+    tgui_f32 sdf_scale;
+    
+    /* NOTE: The glyphs are stored in glyphs in the order they were created */
+    TGuiGlyphArray glyphs;
+    TGuiGlyph *ascii_glyphs[TGUI_FONT_ASCII_GLYPHS];
+    TGuiVirtualMap glyph_map;
+
+    tgui_b32 has_kerning;
+    tgui_s16 *kerning_table;
+    TGuiVirtualMap kerning_map;
 
     tgui_s32 ascent;
     tgui_s32 descent;
@@ -400,16 +523,154 @@ typedef struct TGuiFont {
     struct TGuiOsFont *font;
 } TGuiFont;
 
+TGuiArray(TGuiFontFace, TGuiFontFaceArray);
+TGuiArray(TGuiFont, TGuiFontArray);
+
+/* NOTE: Measured texts are kept in a set associative cache keyed by the font and the text bytes,
+   the least recently used entry of the set is replaced. Texts longer than TGUI_TEXT_CACHE_MAX_SIZE
+   bytes are measured every time in a scratch buffer */
+
+#define TGUI_TEXT_CACHE_SETS 64
+#define TGUI_TEXT_CACHE_WAYS 4
+#define TGUI_TEXT_CACHE_MAX_SIZE 96
+
+typedef struct TGuiTextCacheEntry {
+    tgui_b32 used;
+    tgui_u64 hash;
+    tgui_u32 last_use;
+    
+    TGuiFontHandle font;
+    tgui_u32 size;
+    char text[TGUI_TEXT_CACHE_MAX_SIZE];
+    
+    tgui_u32 codepoints_count;
+    tgui_s32 advances[TGUI_TEXT_CACHE_MAX_SIZE + 1];
+} TGuiTextCacheEntry;
+
+TGuiArray(tgui_s32, TGuiS32Array);
+
+typedef struct TGuiTextCache {
+    TGuiTextCacheEntry *entries;
+    tgui_u32 use_counter;
+    TGuiS32Array scratch_advances;
+} TGuiTextCache;
+
+typedef struct TGuiTextMetrics {
+    tgui_s32 width;
+    tgui_s32 height;
+    tgui_u32 codepoints_count;
+    /* NOTE: advances[i] is the pen position before the codepoint i and advances[codepoints_count]
+       is the width. The memory belongs to the cache and is valid until the next measure */
+    tgui_s32 *advances;
+} TGuiTextMetrics;
+
+/* NOTE: The glyph atlases and the glyphs of the fonts are saved in TGUI_GLYPH_CACHE_FILE_NAME of the
+   cache directory of the user (see tgui_os_get_cache_path) or the path set with
+   tgui_set_glyph_cache_path at terminate and loaded at initialize, so the glyphs rasterized in
+   previous runs are not rasterized or packed again. The glyphs are saved in sets keyed by the hash
+   of the head table and the size of the font file, the pixel size and if they are the sdf glyphs of
+   the face. Bump TGUI_GLYPH_CACHE_VERSION when the format, the rasterizer, the packer or the key
+   change, files with other versions are ignored. The layout of the file is the header, the sets,
+   the glyphs of all the sets and the pixels of the glyph atlas and the sdf glyph atlas */
+
+#define TGUI_GLYPH_CACHE_FILE_NAME "glyphs.dat"
+#define TGUI_GLYPH_CACHE_PATH_SIZE 512
+#define TGUI_GLYPH_CACHE_MAGIC 0x43474754
+#define TGUI_GLYPH_CACHE_VERSION 3
+
+/* NOTE: Sets not used for TGUI_GLYPH_CACHE_MAX_UNUSED_TIME seconds are pruned and the atlases are
+   rebuilt without their glyphs. The time a set was last used is only refreshed once per
+   TGUI_GLYPH_CACHE_USED_TIME_STEP, so the file is not written when no glyph was added */
+#define TGUI_GLYPH_CACHE_MAX_UNUSED_TIME (30*24*60*60)
+#define TGUI_GLYPH_CACHE_USED_TIME_STEP (24*60*60)
+
+typedef struct TGuiGlyphCacheAtlas {
+    tgui_u32 width, height;
+    tgui_u32 current_x;
+    tgui_u32 current_y;
+    tgui_u32 row_height;
+} TGuiGlyphCacheAtlas;
+
+typedef struct TGuiGlyphCacheHeader {
+    tgui_u32 magic;
+    tgui_u32 version;
+    TGuiGlyphCacheAtlas glyph_atlas;
+    TGuiGlyphCacheAtlas sdf_glyph_atlas;
+    tgui_u32 sets_count;
+    tgui_u32 glyphs_count;
+} TGuiGlyphCacheHeader;
+
+typedef struct TGuiGlyphCacheSet {
+    tgui_u64 file_hash;
+    /* NOTE: Seconds since the epoch */
+    tgui_u64 last_used;
+    tgui_u32 size;
+    tgui_b32 sdf;
+    tgui_u32 first_glyph;
+    tgui_u32 glyphs_count;
+} TGuiGlyphCacheSet;
+
+TGuiArray(TGuiGlyphCacheSet, TGuiGlyphCacheSetArray);
+
+typedef struct TGuiGlyphCache {
+    /* NOTE: Empty if the cache is not loaded or saved */
+    char path[TGUI_GLYPH_CACHE_PATH_SIZE];
+    /* NOTE: The file is kept until terminate, the sets of fonts not created in this run are saved again */
+    struct TGuiOsFile *file;
+    TGuiGlyphCacheSet *sets;
+    tgui_u32 sets_count;
+    TGuiGlyph *glyphs;
+    /* NOTE: A glyph was rasterized in this run */
+    tgui_b32 glyphs_added;
+} TGuiGlyphCache;
+
+typedef struct TGuiFontRegistry {
+    TGuiArena *arena;
+    TGuiFontFaceArray faces;
+    TGuiFontArray fonts;
+    TGuiTextCache text_cache;
+    TGuiGlyphCache glyph_cache;
+    TGuiGlyphRasterJobArray raster_jobs;
+    TGuiGlyphRunItemArray glyph_run;
+} TGuiFontRegistry;
+
 void tgui_font_initilize(TGuiArena *arena);
 
 void tgui_font_terminate(void);
 
-TGuiGlyph *tgui_font_get_codepoint_glyph(tgui_u32 codepoint);
+/* NOTE: Save the glyph cache in path instead of the cache directory of the user, it has to be
+   called before tgui_initialize. With NULL the glyph cache is not loaded or saved */
+void tgui_set_glyph_cache_path(char *path);
+
+/* NOTE: Return TGUI_DEFAULT_FONT_FACE if the file cannot be loaded */
+TGuiFontFaceHandle tgui_font_load_face(char *path);
+
+/* NOTE: Return the font of the face with the pixel size, it is created the first time is requested */
+TGuiFontHandle tgui_font_get(TGuiFontFaceHandle face, tgui_u32 pixel_size);
+
+/* NOTE: Same as tgui_font_get but the text is drawn from the signed distance fields of the face */
+TGuiFontHandle tgui_font_get_sdf(TGuiFontFaceHandle face, tgui_u32 pixel_size);
+
+TGuiFont *tgui_font_get_from_handle(TGuiFontHandle font);
+
+/* NOTE: Font used by the widgets created after this call, it is reset to TGUI_DEFAULT_FONT every frame */
+void tgui_set_font(TGuiFontHandle font);
+
+TGuiGlyph *tgui_font_get_codepoint_glyph(TGuiFontHandle font, tgui_u32 codepoint);
+
+/* NOTE: Rasterize the missing glyphs of the codepoints with the worker pool, to load the glyphs of
+   a script or an icon font before they are used. Glyphs not loaded are rasterized when used */
+void tgui_font_load_glyphs(TGuiFontHandle font, tgui_u32 *codepoints, tgui_u32 count);
+
+/* NOTE: Decode the UTF-8 codepoint at text, invalid sequences decode as U+FFFD and consume one byte */
+tgui_u32 tgui_utf8_decode(char *text, tgui_u32 size, tgui_u32 *codepoint);
+
+TGuiTextMetrics tgui_font_measure_text(TGuiFontHandle font, char *text, tgui_u32 size);
 
-TGuiRectangle tgui_get_size_text_dim(tgui_s32 x, tgui_s32 y, char *text, tgui_u32 size);
+TGuiRectangle tgui_get_size_text_dim(TGuiFontHandle font, tgui_s32 x, tgui_s32 y, char *text, tgui_u32 size);
 
-TGuiRectangle tgui_get_text_dim(tgui_s32 x, tgui_s32 y, char *text);
+TGuiRectangle tgui_get_text_dim(TGuiFontHandle font, tgui_s32 x, tgui_s32 y, char *text);
 
-void tgui_font_draw_text(TGuiPainter *painter, tgui_s32 x, tgui_s32 y, char *text, tgui_u32 size, tgui_u32 color);
+void tgui_font_draw_text(TGuiPainter *painter, TGuiFontHandle font, tgui_s32 x, tgui_s32 y, char *text, tgui_u32 size, tgui_u32 color);
 
 #endif /* _TGUI_H_ */
@@ -39,6 +39,8 @@ typedef double             tgui_f64;
 typedef unsigned int       tgui_b32;
 typedef unsigned char      tgui_b8;
 
+#define TGUI_U64_MAX 0xffffffffffffffffull
+
 #define true  1
 #define false 0
 
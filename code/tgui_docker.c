@@ -625,11 +625,11 @@ void node_draw(TGuiPainter *painter, TGuiDockerNode *node) {
             TGuiWindow *window = node->windows->next;
 
             char *label = window->name;
-            TGuiRectangle label_rect = tgui_get_text_dim(0, 0, label);
+            TGuiRectangle label_rect = tgui_get_text_dim(TGUI_DEFAULT_FONT, 0, 0, label);
             
             tgui_s32 label_x = menu_bar_rect.min_x + tgui_rect_width(menu_bar_rect) / 2 - tgui_rect_width(label_rect) / 2;
             tgui_s32 label_y = menu_bar_rect.min_y + tgui_rect_height(menu_bar_rect) / 2 - tgui_rect_height(label_rect) / 2;
-            tgui_font_draw_text(painter, label_x, label_y, label, strlen(label), 0xffffff);
+            tgui_font_draw_text(painter, TGUI_DEFAULT_FONT, label_x, label_y, label, strlen(label), 0xffffff);
 
         } else {
             TGuiWindow *window = node->windows->next;
@@ -642,10 +642,10 @@ void node_draw(TGuiPainter *painter, TGuiDockerNode *node) {
                 painter->clip = tgui_rect_intersection(painter->clip, tab_rect);
 
                 char * label = window->name;
-                TGuiRectangle label_rect = tgui_get_text_dim(0, 0, label);
+                TGuiRectangle label_rect = tgui_get_text_dim(TGUI_DEFAULT_FONT, 0, 0, label);
                 tgui_s32 label_x = tab_rect.min_x + tgui_rect_width(tab_rect) / 2 - tgui_rect_width(label_rect) / 2;
                 tgui_s32 label_y = tab_rect.min_y + tgui_rect_height(tab_rect) / 2 - tgui_rect_height(label_rect) / 2;
-                tgui_font_draw_text(painter, label_x, label_y, label, strlen(label), 0xffffff);
+                tgui_font_draw_text(painter, TGUI_DEFAULT_FONT, label_x, label_y, label, strlen(label), 0xffffff);
                 
                 if(window->id == node->active_window) {
                     TGuiWindow *active_window = tgui_window_node_get_active_window(node);
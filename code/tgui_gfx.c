@@ -13,7 +13,7 @@ TGuiBitmap tgui_bitmap_alloc_empty(TGuiArena *arena, tgui_u32 w, tgui_u32 h) {
     bitmap.pixels  = tgui_arena_alloc(arena, bitmap_size, 8);
     bitmap.width   = w;
     bitmap.height  = h;
-    bitmap.texture = NULL;
+    bitmap.texture = TGUI_TEXTURE_HANDLE_INVALID;
     
     memset(bitmap.pixels, 0, bitmap_size);
 
@@ -26,160 +26,853 @@ TGuiBitmap tgui_bitmap_copy(TGuiArena *arena, TGuiBitmap *bitmap) {
     
     tgui_u64 bitmap_size = bitmap->width*bitmap->height*sizeof(tgui_u32);
     memcpy(result.pixels, bitmap->pixels, bitmap_size);
+    
+    return result;
+}
+
+/* ----------------------------- */
+/*       TGui Skyline Packer     */
+/* ----------------------------- */
+
+void tgui_skyline_initialize(TGuiSkyline *skyline, tgui_u32 width, tgui_u32 height) {
+    tgui_arena_initialize(&skyline->arena, 0, TGUI_ARENA_TYPE_VIRTUAL);
+    skyline->nodes = NULL;
+    tgui_skyline_reset(skyline, width, height);
+}
+
+void tgui_skyline_terminate(TGuiSkyline *skyline) {
+    tgui_arena_terminate(&skyline->arena);
+    memset(skyline, 0, sizeof(TGuiSkyline));
+}
+
+void tgui_skyline_reset(TGuiSkyline *skyline, tgui_u32 width, tgui_u32 height) {
+    
+    TGUI_ASSERT(width > 0);
+
+    tgui_arena_free(&skyline->arena);
+    skyline->nodes = tgui_arena_push_array(&skyline->arena, TGuiSkylineNode, width, 8);
+    
+    skyline->width = width;
+    skyline->height = height;
+    
+    skyline->nodes[0].x = 0;
+    skyline->nodes[0].y = 0;
+    skyline->nodes[0].width = width;
+    skyline->nodes_count = 1;
+}
+
+void tgui_skyline_set_height(TGuiSkyline *skyline, tgui_u32 height) {
+    TGUI_ASSERT(height >= tgui_skyline_get_used_height(skyline));
+    skyline->height = height;
+}
+
+/* NOTE: Returns the y where a rect of w*h starting at the node fits or false if it does not fit */
+static tgui_b32 skyline_fit(TGuiSkyline *skyline, tgui_u32 index, tgui_u32 w, tgui_u32 h, tgui_u32 *y) {
+    
+    if(skyline->nodes[index].x + w > skyline->width) return false;
+
+    tgui_u32 result = 0;
+    tgui_u32 width_left = w;
+    while(width_left > 0) {
+        TGUI_ASSERT(index < skyline->nodes_count);
+        TGuiSkylineNode *node = skyline->nodes + index;
+        result = TGUI_MAX(result, node->y);
+        if(result + h > skyline->height) return false;
+        width_left -= TGUI_MIN(width_left, node->width);
+        ++index;
+    }
+
+    *y = result;
+    return true;
+}
 
-    result.texture = bitmap->texture;
+tgui_b32 tgui_skyline_insert(TGuiSkyline *skyline, tgui_u32 w, tgui_u32 h, tgui_u32 *x, tgui_u32 *y) {
+
+    if(w == 0 || h == 0 || w > skyline->width) return false;
+
+    tgui_u32 best_index = skyline->nodes_count;
+    tgui_u32 best_bottom = 0;
+    tgui_u32 best_width = 0;
+    tgui_u32 best_y = 0;
+
+    for(tgui_u32 i = 0; i < skyline->nodes_count; ++i) {
+        tgui_u32 node_y;
+        if(!skyline_fit(skyline, i, w, h, &node_y)) continue;
+        tgui_u32 bottom = node_y + h;
+        if(best_index == skyline->nodes_count || bottom < best_bottom || (bottom == best_bottom && skyline->nodes[i].width < best_width)) {
+            best_index = i;
+            best_bottom = bottom;
+            best_width = skyline->nodes[i].width;
+            best_y = node_y;
+        }
+    }
+
+    if(best_index == skyline->nodes_count) return false;
+
+    *x = skyline->nodes[best_index].x;
+    *y = best_y;
+
+    /* NOTE: Insert the new segment and shrink or remove the segments it covers */
+    TGUI_ASSERT(skyline->nodes_count < skyline->width);
+    memmove(skyline->nodes + best_index + 1, skyline->nodes + best_index, (skyline->nodes_count - best_index) * sizeof(TGuiSkylineNode));
+    ++skyline->nodes_count;
     
+    TGuiSkylineNode *new_node = skyline->nodes + best_index;
+    new_node->x = *x;
+    new_node->y = best_y + h;
+    new_node->width = w;
+
+    tgui_u32 new_node_end = new_node->x + new_node->width;
+    tgui_u32 index = best_index + 1;
+    while(index < skyline->nodes_count) {
+        TGuiSkylineNode *node = skyline->nodes + index;
+        if(node->x >= new_node_end) break;
+        
+        tgui_u32 node_end = node->x + node->width;
+        if(node_end <= new_node_end) {
+            memmove(node, node + 1, (skyline->nodes_count - index - 1) * sizeof(TGuiSkylineNode));
+            --skyline->nodes_count;
+        } else {
+            node->width = node_end - new_node_end;
+            node->x = new_node_end;
+            break;
+        }
+    }
+
+    /* NOTE: Merge the neighbours at the same height */
+    for(tgui_u32 i = 0; i + 1 < skyline->nodes_count;) {
+        TGuiSkylineNode *node = skyline->nodes + i;
+        if(node->y == node[1].y) {
+            node->width += node[1].width;
+            memmove(node + 1, node + 2, (skyline->nodes_count - i - 2) * sizeof(TGuiSkylineNode));
+            --skyline->nodes_count;
+        } else {
+            ++i;
+        }
+    }
+
+    return true;
+}
+
+tgui_u32 tgui_skyline_get_used_height(TGuiSkyline *skyline) {
+    tgui_u32 result = 0;
+    for(tgui_u32 i = 0; i < skyline->nodes_count; ++i) {
+        result = TGUI_MAX(result, skyline->nodes[i].y);
+    }
     return result;
 }
 
+/* ----------------------------- */
+/*       TGui Texture Atlas      */
+/* ----------------------------- */
+
 void tgui_texture_atlas_initialize(TGuiTextureAtlas *texture_atlas) {
     tgui_arena_initialize(&texture_atlas->arena, 0, TGUI_ARENA_TYPE_VIRTUAL);
     tgui_array_initialize(&texture_atlas->textures);
+    tgui_array_initialize(&texture_atlas->free_textures);
 
     texture_atlas->bitmap.pixels = NULL;
     texture_atlas->bitmap.height = 0;
-    texture_atlas->bitmap.width = TGUI_TEXTURE_ATLAS_START_WIDTH;
+    texture_atlas->bitmap.width = TGUI_TEXTURE_ATLAS_PAGE_SIZE;
+
+    tgui_array_initialize(&texture_atlas->pages);
+
+    tgui_array_initialize(&texture_atlas->pending_textures);
+    texture_atlas->generated = false;
 
-    texture_atlas->current_x = 0;
-    texture_atlas->current_y = 0;
+    /* NOTE: Starts at one so the textures never drawn are the least recently used */
+    texture_atlas->frame = 1;
+    texture_atlas->max_pages = TGUI_TEXTURE_ATLAS_DEFAULT_MAX_PAGES;
+    texture_atlas->over_budget = false;
+    texture_atlas->over_budget_area = TGUI_U64_MAX;
+
+    tgui_array_initialize(&texture_atlas->pack_textures);
+
+    texture_atlas->texture_pages_count = 0;
+    texture_atlas->compacted = false;
+
+    texture_atlas->binner = tgui_arena_push_struct(&state.arena, TGuiTileBinner, 8);
+    tgui_tile_binner_initialize(texture_atlas->binner);
+}
+
+static void texture_atlas_clear_pages(TGuiTextureAtlas *texture_atlas) {
+    for(tgui_u32 i = 0; i < tgui_array_size(&texture_atlas->pages); ++i) {
+        tgui_skyline_terminate(&tgui_array_get_ptr(&texture_atlas->pages, i)->skyline);
+    }
+    tgui_array_clear(&texture_atlas->pages);
 }
 
 void tgui_texture_atlas_terminate(TGuiTextureAtlas *texture_atlas) {
+    tgui_tile_binner_terminate(texture_atlas->binner);
+    texture_atlas_clear_pages(texture_atlas);
+    tgui_array_terminate(&texture_atlas->pages);
+    tgui_array_terminate(&texture_atlas->pack_textures);
+    tgui_array_terminate(&texture_atlas->pending_textures);
+    tgui_array_terminate(&texture_atlas->free_textures);
     tgui_array_terminate(&texture_atlas->textures);
     tgui_arena_terminate(&texture_atlas->arena);
     memset(texture_atlas, 0, sizeof(TGuiTextureAtlas));
 
 }
 
-void tgui_texture_atlas_add_bitmap(TGuiTextureAtlas *texture_atlas, TGuiBitmap *bitmap) {
+static tgui_b32 texture_atlas_try_insert(TGuiTextureAtlas *texture_atlas, TGuiTexture *texture);
 
-    TGuiTexture *texture = tgui_arena_push_struct(&state.arena, TGuiTexture, 8);
+static TGuiRectangle dirty_rect_add(TGuiRectangle dirty_rect, TGuiRectangle rect) {
+    if(tgui_rect_invalid(dirty_rect)) return rect;
+    return tgui_rect_union(dirty_rect, rect);
+}
+
+static TGuiTextureHandle texture_handle(tgui_u32 index, tgui_u32 generation) {
+    return (generation << TGUI_TEXTURE_HANDLE_INDEX_BITS) | index;
+}
+
+/* NOTE: Returns NULL if the bitmap of the handle was removed */
+static TGuiTexture *texture_atlas_get_texture(TGuiTextureAtlas *texture_atlas, TGuiTextureHandle handle) {
+    
+    tgui_u32 index = handle & TGUI_TEXTURE_HANDLE_INDEX_MASK;
+    if(index >= tgui_array_size(&texture_atlas->textures)) return NULL;
+    
+    TGuiTexture *texture = tgui_array_get_ptr(&texture_atlas->textures, index);
+    if(!texture->bitmap || texture_handle(index, texture->generation) != handle) return NULL;
+    
+    return texture;
+}
+
+TGuiTextureHandle tgui_texture_atlas_add_bitmap(TGuiTextureAtlas *texture_atlas, TGuiBitmap *bitmap) {
+
+    TGUI_ASSERT(bitmap->width + TGUI_TEXTURE_ATLAS_DEFAULT_PADDING <= TGUI_TEXTURE_ATLAS_PAGE_SIZE);
+    TGUI_ASSERT(bitmap->height + TGUI_TEXTURE_ATLAS_DEFAULT_PADDING <= TGUI_TEXTURE_ATLAS_PAGE_SIZE);
+
+    tgui_u32 index;
+    if(tgui_array_size(&texture_atlas->free_textures) > 0) {
+        index = tgui_array_pop(&texture_atlas->free_textures);
+    } else {
+        /* NOTE: The last index is never used so no handle is TGUI_TEXTURE_HANDLE_INVALID */
+        index = tgui_array_size(&texture_atlas->textures);
+        TGUI_ASSERT(index < TGUI_TEXTURE_HANDLE_INDEX_MASK);
+        TGuiTexture *new_texture = tgui_array_push(&texture_atlas->textures);
+        new_texture->generation = 0;
+    }
+
+    TGuiTexture *texture = tgui_array_get_ptr(&texture_atlas->textures, index);
     texture->bitmap = bitmap;
     texture->dim = tgui_rect_set_invalid();
+    texture->page = 0;
+    texture->min_u = texture->min_v = 0.0f;
+    texture->max_u = texture->max_v = 0.0f;
+    texture->last_used_frame = 0;
+    texture->pending = false;
     
-    TGuiTextureBucket *bucket = tgui_array_push(&texture_atlas->textures);
-    bucket->texture = texture;
+    TGuiTextureHandle handle = texture_handle(index, texture->generation);
+    bitmap->texture = handle;
+
+    /* NOTE: If there is no free space the texture waits until it is drawn */
+    if(texture_atlas->generated) {
+        texture_atlas_try_insert(texture_atlas, texture);
+    }
+
+    return handle;
+}
+
+void tgui_texture_atlas_remove_bitmap(TGuiTextureAtlas *texture_atlas, TGuiBitmap *bitmap) {
+    
+    TGuiTexture *texture = texture_atlas_get_texture(texture_atlas, bitmap->texture);
+    TGUI_ASSERT(texture && texture->bitmap == bitmap);
+    if(!texture) return;
     
-    bitmap->texture = texture;
+    texture->bitmap = NULL;
+    texture->dim = tgui_rect_set_invalid();
+    texture->pending = false;
+    texture->generation = (texture->generation + 1) & TGUI_TEXTURE_HANDLE_GENERATION_MASK;
+    
+    *tgui_array_push(&texture_atlas->free_textures) = bitmap->texture & TGUI_TEXTURE_HANDLE_INDEX_MASK;
+    
+    bitmap->texture = TGUI_TEXTURE_HANDLE_INVALID;
 }
 
-void texture_atlas_sort_textures_per_height(TGuiTextureAtlas *texture_atlas) {
+TGuiTexture *tgui_texture_atlas_use_texture(TGuiTextureAtlas *texture_atlas, TGuiTextureHandle handle) {
     
-    for(tgui_u32 i = 0; i < tgui_array_size(&texture_atlas->textures); ++i) {
-        
-        TGuiTextureBucket *bucket = tgui_array_get_ptr(&texture_atlas->textures, i);
+    TGuiTexture *texture = texture_atlas_get_texture(texture_atlas, handle);
+    if(!texture) return NULL;
 
-        for(tgui_u32 j = i; j < tgui_array_size(&texture_atlas->textures); ++j) {
-            
-            if(i == j) continue;
+    texture->last_used_frame = texture_atlas->frame;
+    if(!tgui_rect_invalid(texture->dim)) return texture;
 
-            TGuiTexture *texture = bucket->texture;
-            tgui_u32 h = texture->bitmap->height;
+    if(!texture->pending) {
+        texture->pending = true;
+        *tgui_array_push(&texture_atlas->pending_textures) = handle & TGUI_TEXTURE_HANDLE_INDEX_MASK;
+    }
+    
+    return NULL;
+}
+
+void tgui_texture_atlas_set_max_pages(TGuiTextureAtlas *texture_atlas, tgui_u32 max_pages) {
+    TGUI_ASSERT(max_pages > 0 && max_pages <= TGUI_TEXTURE_ATLAS_MAX_PAGES);
+    texture_atlas->max_pages = max_pages;
+}
 
-            TGuiTextureBucket *other_bucket = tgui_array_get_ptr(&texture_atlas->textures, j);
-            TGuiTexture *other_texture = other_bucket->texture;
+/* NOTE: Most recently used textures first, the older handles first for the same frame */
+static int texture_atlas_compare_last_used(const void *a, const void *b) {
+    TGuiTexture *texture_a = *(TGuiTexture * const *)a;
+    TGuiTexture *texture_b = *(TGuiTexture * const *)b;
+    if(texture_a->last_used_frame != texture_b->last_used_frame) return (texture_a->last_used_frame < texture_b->last_used_frame) ? 1 : -1;
+    if(texture_a != texture_b) return (texture_a > texture_b) ? 1 : -1;
+    return 0;
+}
 
-            tgui_u32 other_h = other_texture->bitmap->height;
+/* NOTE: Taller textures first, the wider first for the same height */
+static int texture_atlas_compare_textures(const void *a, const void *b) {
+    TGuiBitmap *bitmap_a = (*(TGuiTexture * const *)a)->bitmap;
+    TGuiBitmap *bitmap_b = (*(TGuiTexture * const *)b)->bitmap;
+    if(bitmap_a->height != bitmap_b->height) return (bitmap_a->height < bitmap_b->height) ? 1 : -1;
+    if(bitmap_a->width != bitmap_b->width) return (bitmap_a->width < bitmap_b->width) ? 1 : -1;
+    return 0;
+}
 
-            if(h < other_h) {
-                TGuiTextureBucket temp = *bucket;
-                *bucket = *other_bucket;
-                *other_bucket = temp;
-            }
-        }
+static void texture_update_uvs(TGuiTexture *texture) {
+    tgui_f32 page_size = (tgui_f32)TGUI_TEXTURE_ATLAS_PAGE_SIZE;
+    texture->min_u = (tgui_f32)texture->dim.min_x / page_size;
+    texture->min_v = (tgui_f32)texture->dim.min_y / page_size;
+    texture->max_u = (tgui_f32)(texture->dim.max_x + 1) / page_size;
+    texture->max_v = (tgui_f32)(texture->dim.max_y + 1) / page_size;
+}
+
+/* NOTE: Add an empty page to the packer, the bitmap is not resized */
+static TGuiTextureAtlasPage *texture_atlas_push_page(TGuiTextureAtlas *texture_atlas) {
+    
+    TGUI_ASSERT(tgui_array_size(&texture_atlas->pages) < TGUI_TEXTURE_ATLAS_MAX_PAGES);
+
+    TGuiTextureAtlasPage *page = tgui_array_push(&texture_atlas->pages);
+    tgui_skyline_initialize(&page->skyline, TGUI_TEXTURE_ATLAS_PAGE_SIZE, TGUI_TEXTURE_ATLAS_PAGE_SIZE);
+    page->dirty_rect = tgui_rect_set_invalid();
+    return page;
+}
+
+/* NOTE: Add pages at the end of the bitmap until it has the pages of the packer, the pages already
+   packed keep their position. The bitmap is the only allocation of the virtual arena of the atlas
+   so it grows in place and only the new pages are cleared */
+static void texture_atlas_grow_bitmap(TGuiTextureAtlas *texture_atlas) {
+    
+    TGuiBitmap *bitmap = &texture_atlas->bitmap;
+    tgui_u64 page_size = (tgui_u64)TGUI_TEXTURE_ATLAS_PAGE_SIZE * TGUI_TEXTURE_ATLAS_PAGE_SIZE * sizeof(tgui_u32);
+    
+    while(bitmap->height < tgui_array_size(&texture_atlas->pages) * TGUI_TEXTURE_ATLAS_PAGE_SIZE) {
+        tgui_u32 *page_pixels = tgui_arena_alloc(&texture_atlas->arena, page_size, 8);
+        TGUI_ASSERT(page_pixels == bitmap->pixels + (tgui_u64)bitmap->width*bitmap->height); TGUI_UNUSED(page_pixels);
+        memset(page_pixels, 0, page_size);
+
+        bitmap->height += TGUI_TEXTURE_ATLAS_PAGE_SIZE;
     }
 }
 
-void texture_atlas_insert(TGuiTextureAtlas *texture_atlas, TGuiTexture *texture) {
-   TGuiBitmap *texture_atlas_bitmap = &texture_atlas->bitmap;
+/* NOTE: Drop the pages at the end of the bitmap that the packer does not use anymore and decommit
+   their memory */
+static void texture_atlas_shrink_bitmap(TGuiTextureAtlas *texture_atlas) {
+    
+    TGuiBitmap *bitmap = &texture_atlas->bitmap;
+    TGUI_ASSERT((tgui_u8 *)bitmap->pixels == texture_atlas->arena.buffer);
+    
+    bitmap->height = tgui_array_size(&texture_atlas->pages) * TGUI_TEXTURE_ATLAS_PAGE_SIZE;
+    tgui_virtual_arena_shrink(&texture_atlas->arena, (tgui_u64)bitmap->width*bitmap->height*sizeof(tgui_u32));
+}
+
+static void texture_atlas_add_page(TGuiTextureAtlas *texture_atlas) {
+    texture_atlas_push_page(texture_atlas);
+    texture_atlas_grow_bitmap(texture_atlas);
+}
+
+/* NOTE: Copy the bitmap of the texture to its dim in its page */
+static void texture_atlas_copy_bitmap(TGuiTextureAtlas *texture_atlas, TGuiTexture *texture) {
+   
+    TGuiBitmap *texture_atlas_bitmap = &texture_atlas->bitmap;
+    
+    texture_update_uvs(texture);
+
+    TGuiPainter painter;
+    TGuiRectangle texture_atlas_rect = tgui_rect_from_wh(0, 0,texture_atlas_bitmap->width, texture_atlas_bitmap->height);
+    tgui_painter_start(&painter, TGUI_PAINTER_TYPE_SOFTWARE, texture_atlas_rect, 0, texture_atlas_bitmap->pixels, NULL);
+    
+    tgui_s32 page_y = texture->page * TGUI_TEXTURE_ATLAS_PAGE_SIZE;
+    tgui_painter_draw_bitmap_no_alpha(&painter, texture->dim.min_x, page_y + texture->dim.min_y, texture->bitmap);
+}
+
+/* NOTE: Copy the textures in the atlas and the white texel to a cleared bitmap, the copies are
+   rasterized in parallel by the binned painter */
+static void texture_atlas_copy_textures(TGuiTextureAtlas *texture_atlas) {
+    
+    TGuiBitmap *texture_atlas_bitmap = &texture_atlas->bitmap;
+    texture_atlas_bitmap->pixels[0] = 0xffffffff;
+    
+    TGuiPainter painter;
+    TGuiRectangle texture_atlas_rect = tgui_rect_from_wh(0, 0, texture_atlas_bitmap->width, texture_atlas_bitmap->height);
+    tgui_painter_start_binned(&painter, texture_atlas_rect, 0, texture_atlas_bitmap->pixels, texture_atlas->binner);
+    
+    for(tgui_u32 i = 0; i < tgui_array_size(&texture_atlas->textures); ++i) {
+        TGuiTexture *texture = tgui_array_get_ptr(&texture_atlas->textures, i);
+        if(tgui_rect_invalid(texture->dim)) continue;
+        
+        texture_update_uvs(texture);
+        tgui_s32 page_y = texture->page * TGUI_TEXTURE_ATLAS_PAGE_SIZE;
+        tgui_painter_draw_bitmap_no_alpha(&painter, texture->dim.min_x, page_y + texture->dim.min_y, texture->bitmap);
+    }
+
+    tgui_painter_flush(&painter);
+}
+
+/* NOTE: Find a place for the texture in the first page with space, the bitmap is not copied */
+static tgui_b32 texture_atlas_pack(TGuiTextureAtlas *texture_atlas, TGuiTexture *texture) {
     
     TGuiBitmap *bitmap = texture->bitmap;
     TGUI_ASSERT(bitmap);
 
-    if(texture_atlas_bitmap->pixels == NULL) {
+    for(tgui_u32 i = 0; i < tgui_array_size(&texture_atlas->pages); ++i) {
+        TGuiTextureAtlasPage *page = tgui_array_get_ptr(&texture_atlas->pages, i);
+        tgui_u32 x, y;
+        if(tgui_skyline_insert(&page->skyline, bitmap->width + TGUI_TEXTURE_ATLAS_DEFAULT_PADDING, bitmap->height + TGUI_TEXTURE_ATLAS_DEFAULT_PADDING, &x, &y)) {
+            texture->dim = tgui_rect_from_wh(x, y, bitmap->width, bitmap->height);
+            texture->page = i;
+            return true;
+        }
+    }
+    
+    return false;
+}
 
-        texture_atlas->last_row_added_height = bitmap->height + TGUI_TEXTURE_ATLAS_DEFAULT_PADDING;
-        texture_atlas_bitmap->height = texture_atlas->last_row_added_height;
-        
-        tgui_u64 texture_atlas_size = texture_atlas_bitmap->width*texture_atlas_bitmap->height*sizeof(tgui_u32);
-        texture_atlas_bitmap->pixels = tgui_arena_alloc(&texture_atlas->arena, texture_atlas_size, 8);
-        
-        memset(texture_atlas_bitmap->pixels, 0, texture_atlas_size);
+/* NOTE: Insert the texture in the free space of the pages without adding a page, the texture
+   coordinates already pushed this frame stay valid. Returns false if there is no space left */
+static tgui_b32 texture_atlas_try_insert(TGuiTextureAtlas *texture_atlas, TGuiTexture *texture) {
+    
+    TGUI_ASSERT(texture_atlas->bitmap.pixels);
+
+    if(!texture_atlas_pack(texture_atlas, texture)) return false;
+
+    texture->pending = false;
+    texture_atlas_copy_bitmap(texture_atlas, texture);
+    
+    TGuiTextureAtlasPage *page = tgui_array_get_ptr(&texture_atlas->pages, texture->page);
+    page->dirty_rect = dirty_rect_add(page->dirty_rect, texture->dim);
+
+    return true;
+}
+
+static tgui_u64 texture_atlas_get_max_area(TGuiTextureAtlas *texture_atlas, tgui_f32 fill) {
+    tgui_u64 page_area = (tgui_u64)TGUI_TEXTURE_ATLAS_PAGE_SIZE * TGUI_TEXTURE_ATLAS_PAGE_SIZE;
+    return (tgui_u64)((tgui_f64)fill * (tgui_f64)(page_area * texture_atlas->max_pages));
+}
+
+/* NOTE: Area of the textures used in used_frame with their padding and the white texel */
+static tgui_u64 texture_atlas_get_used_area(TGuiTextureAtlas *texture_atlas, tgui_u64 used_frame) {
+    tgui_u64 area = (1 + TGUI_TEXTURE_ATLAS_DEFAULT_PADDING) * (1 + TGUI_TEXTURE_ATLAS_DEFAULT_PADDING);
+    for(tgui_u32 i = 0; i < tgui_array_size(&texture_atlas->textures); ++i) {
+        TGuiTexture *texture = tgui_array_get_ptr(&texture_atlas->textures, i);
+        if(!texture->bitmap || texture->last_used_frame != used_frame) continue;
+        area += (tgui_u64)(texture->bitmap->width + TGUI_TEXTURE_ATLAS_DEFAULT_PADDING) * (texture->bitmap->height + TGUI_TEXTURE_ATLAS_DEFAULT_PADDING);
+    }
+    return area;
+}
+
+/* NOTE: Pack again the textures of the atlas and the pending ones in up to max_pages. The textures
+   used in used_frame are always kept, then the most recently used ones until fill of the area of
+   max_pages is used, the rest are evicted. The bitmap is not resized or copied */
+static void texture_atlas_pack_textures(TGuiTextureAtlas *texture_atlas, tgui_f32 fill, tgui_u64 used_frame) {
+
+    TGuiTexturePtrArray *pack_textures = &texture_atlas->pack_textures;
+    tgui_array_clear(pack_textures);
+
+    for(tgui_u32 i = 0; i < tgui_array_size(&texture_atlas->textures); ++i) {
+        TGuiTexture *texture = tgui_array_get_ptr(&texture_atlas->textures, i);
+        if(!texture->bitmap) continue;
+        if(texture_atlas->generated && tgui_rect_invalid(texture->dim) && !texture->pending) continue;
         
-        texture_atlas_bitmap->pixels[0] = 0xffffffff;
-        texture_atlas->current_x = 1 + TGUI_TEXTURE_ATLAS_DEFAULT_PADDING;
+        texture->dim = tgui_rect_set_invalid();
+        texture->pending = false;
+        *tgui_array_push(pack_textures) = texture;
+    }
+
+    tgui_u32 textures_count = tgui_array_size(pack_textures);
+    if(textures_count > 0) {
+        qsort(tgui_array_data(pack_textures), textures_count, sizeof(TGuiTexture *), texture_atlas_compare_last_used);
+    }
+
+    tgui_u64 max_area = texture_atlas_get_max_area(texture_atlas, fill);
+    tgui_u64 area = (1 + TGUI_TEXTURE_ATLAS_DEFAULT_PADDING) * (1 + TGUI_TEXTURE_ATLAS_DEFAULT_PADDING);
+    
+    tgui_u32 used_count = 0;
+    tgui_u32 kept_count = 0;
+    while(kept_count < textures_count) {
+        TGuiTexture *texture = tgui_array_get(pack_textures, kept_count);
+        TGuiBitmap *bitmap = texture->bitmap;
+        tgui_u64 texture_area = (tgui_u64)(bitmap->width + TGUI_TEXTURE_ATLAS_DEFAULT_PADDING) * (bitmap->height + TGUI_TEXTURE_ATLAS_DEFAULT_PADDING);
+        if(texture->last_used_frame == used_frame) {
+            ++used_count;
+        } else if(area + texture_area > max_area) {
+            break;
+        }
+        area += texture_area;
+        ++kept_count;
+    }
+
+    /* NOTE: The used textures are packed before the others so they never lose their place to
+       a texture that can be evicted */
+    if(used_count > 0) {
+        qsort(tgui_array_data(pack_textures), used_count, sizeof(TGuiTexture *), texture_atlas_compare_textures);
+    }
+    if(kept_count > used_count) {
+        qsort(tgui_array_data(pack_textures) + used_count, kept_count - used_count, sizeof(TGuiTexture *), texture_atlas_compare_textures);
     }
 
-    TGUI_ASSERT(texture_atlas_bitmap->pixels);
-    TGUI_ASSERT(texture_atlas_bitmap->height >= bitmap->height);
+    /* NOTE: The first rect of the first page is the white texel used by the solid quads */
+    texture_atlas_clear_pages(texture_atlas);
+    TGuiTextureAtlasPage *first_page = texture_atlas_push_page(texture_atlas);
+    
+    tgui_u32 white_x, white_y;
+    tgui_b32 white_inserted = tgui_skyline_insert(&first_page->skyline, 1 + TGUI_TEXTURE_ATLAS_DEFAULT_PADDING, 1 + TGUI_TEXTURE_ATLAS_DEFAULT_PADDING, &white_x, &white_y);
+    TGUI_ASSERT(white_inserted && white_x == 0 && white_y == 0); TGUI_UNUSED(white_inserted);
+    
+    /* NOTE: The textures that do not fit in max_pages are evicted, the used ones add pages over
+       the budget */
+    for(tgui_u32 i = 0; i < kept_count; ++i) {
+        TGuiTexture *texture = tgui_array_get(pack_textures, i);
+        if(texture_atlas_pack(texture_atlas, texture)) continue;
+        if(i < used_count || tgui_array_size(&texture_atlas->pages) < texture_atlas->max_pages) {
+            texture_atlas_push_page(texture_atlas);
+            tgui_b32 packed = texture_atlas_pack(texture_atlas, texture);
+            TGUI_ASSERT(packed); TGUI_UNUSED(packed);
+        }
+    }
+
+    texture_atlas->over_budget = tgui_array_size(&texture_atlas->pages) > texture_atlas->max_pages;
+}
+
+/* NOTE: Evict the least recently used textures and pack the rest again without the holes left by
+   the removed and evicted ones. The atlas keeps its pages up to max_pages so the texture is not
+   created again, the pages added over the budget are dropped once the textures fit in max_pages.
+   The atlas is uploaded on the next frame */
+static void texture_atlas_compact(TGuiTextureAtlas *texture_atlas, tgui_u64 used_frame) {
+    
+    texture_atlas_pack_textures(texture_atlas, TGUI_TEXTURE_ATLAS_COMPACT_FILL, used_frame);
+    
+    TGuiBitmap *bitmap = &texture_atlas->bitmap;
+    tgui_u32 bitmap_pages_count = bitmap->height / TGUI_TEXTURE_ATLAS_PAGE_SIZE;
+    while(tgui_array_size(&texture_atlas->pages) < TGUI_MIN(bitmap_pages_count, texture_atlas->max_pages)) {
+        texture_atlas_push_page(texture_atlas);
+    }
+    if(tgui_array_size(&texture_atlas->pages) < bitmap_pages_count) {
+        texture_atlas_shrink_bitmap(texture_atlas);
+    } else {
+        texture_atlas_grow_bitmap(texture_atlas);
+    }
+
+    memset(bitmap->pixels, 0, (tgui_u64)bitmap->width*bitmap->height*sizeof(tgui_u32));
+    texture_atlas_copy_textures(texture_atlas);
+
+    for(tgui_u32 i = 0; i < tgui_array_size(&texture_atlas->pages); ++i) {
+        TGuiTextureAtlasPage *page = tgui_array_get_ptr(&texture_atlas->pages, i);
+        page->dirty_rect = tgui_rect_from_wh(0, 0, TGUI_TEXTURE_ATLAS_PAGE_SIZE, TGUI_TEXTURE_ATLAS_PAGE_SIZE);
+    }
+
+    texture_atlas->compacted = true;
+}
+
+void tgui_texture_atlas_generate_atlas(void) {
+    TGuiTextureAtlas *texture_atlas = state.default_texture_atlas;
+
+    texture_atlas_pack_textures(texture_atlas, 1.0f, texture_atlas->frame);
+    tgui_array_clear(&texture_atlas->pending_textures);
+
+    tgui_u32 pages_count = tgui_array_size(&texture_atlas->pages);
+
+    tgui_arena_free(&texture_atlas->arena);
+    texture_atlas->bitmap = tgui_bitmap_alloc_empty(&texture_atlas->arena, TGUI_TEXTURE_ATLAS_PAGE_SIZE, pages_count * TGUI_TEXTURE_ATLAS_PAGE_SIZE);
+    texture_atlas_copy_textures(texture_atlas);
+
+    texture_atlas->generated = true;
+
+    state.default_texture = state.render_state.gfx->create_texture(texture_atlas->bitmap.pixels, TGUI_TEXTURE_ATLAS_PAGE_SIZE, TGUI_TEXTURE_ATLAS_PAGE_SIZE, pages_count);
+    texture_atlas->texture_pages_count = pages_count;
+}
+
+tgui_b32 tgui_texture_atlas_insert_pending(TGuiTextureAtlas *texture_atlas) {
     
-    tgui_s32 width_left = texture_atlas_bitmap->width - texture_atlas->current_x; (void) width_left;
-    if(width_left < (tgui_s32)bitmap->width) {
+    tgui_u64 used_frame = texture_atlas->frame++;
+    if(!texture_atlas->generated) return false;
+
+    /* NOTE: Over the budget the atlas is compacted as soon as the textures drawn fit in max_pages
+       again. If they still need more pages it waits until less area is drawn to try again */
+    if(texture_atlas->over_budget) {
+        tgui_u64 used_area = texture_atlas_get_used_area(texture_atlas, used_frame);
+        if(used_area <= texture_atlas_get_max_area(texture_atlas, TGUI_TEXTURE_ATLAS_COMPACT_FILL) && used_area < texture_atlas->over_budget_area) {
+            texture_atlas_compact(texture_atlas, used_frame);
+            texture_atlas->over_budget_area = used_area;
+            tgui_array_clear(&texture_atlas->pending_textures);
+            return true;
+        }
+    }
+
+    tgui_u32 pending_count = tgui_array_size(&texture_atlas->pending_textures);
+    if(pending_count == 0) return false;
+
+    tgui_u32 old_pages_count = tgui_array_size(&texture_atlas->pages);
+    tgui_b32 compacted = false;
 
-        printf("texture atlas was resize\n");
+    for(tgui_u32 i = 0; i < pending_count; ++i) {
         
-        tgui_u64 temp_arena_checkpoint = state.arena.used;
+        tgui_u32 index = tgui_array_get(&texture_atlas->pending_textures, i);
+        TGuiTexture *texture = tgui_array_get_ptr(&texture_atlas->textures, index);
         
-        TGuiBitmap old_texture_atlas_bitmap = tgui_bitmap_copy(&state.arena, &texture_atlas->bitmap);
+        /* NOTE: The texture was removed or already inserted */
+        if(!texture->pending) continue;
         
-        tgui_u32 new_row_height = bitmap->height + TGUI_TEXTURE_ATLAS_DEFAULT_PADDING;
-        tgui_u32 new_texture_atlas_w = texture_atlas->bitmap.width;
-        tgui_u32 new_texture_atlas_h = texture_atlas->bitmap.height + new_row_height;
+        if(texture_atlas_try_insert(texture_atlas, texture)) continue;
 
-        tgui_arena_free(&texture_atlas->arena);
-        texture_atlas->bitmap = tgui_bitmap_alloc_empty(&texture_atlas->arena, new_texture_atlas_w, new_texture_atlas_h);
+        if(tgui_array_size(&texture_atlas->pages) < texture_atlas->max_pages) {
+            texture_atlas_add_page(texture_atlas);
+            tgui_b32 inserted = texture_atlas_try_insert(texture_atlas, texture);
+            TGUI_ASSERT(inserted); TGUI_UNUSED(inserted);
+            continue;
+        }
+        
+        /* NOTE: The rest of the pending textures are packed with the compaction */
+        texture_atlas_compact(texture_atlas, used_frame);
+        texture_atlas->over_budget_area = TGUI_U64_MAX;
+        compacted = true;
+        break;
+    }
 
-        TGuiPainter painter;
-        TGuiRectangle texture_atlas_rect = tgui_rect_from_wh(0, 0,texture_atlas->bitmap.width, texture_atlas->bitmap.height);
-        tgui_painter_start(&painter, TGUI_PAINTER_TYPE_SOFTWARE, texture_atlas_rect, 0, texture_atlas->bitmap.pixels, NULL);
-        tgui_painter_draw_bitmap_no_alpha(&painter, 0, 0, &old_texture_atlas_bitmap);
+    tgui_array_clear(&texture_atlas->pending_textures);
 
-        state.arena.used = temp_arena_checkpoint;
-        
-        texture_atlas->current_x = 0;
-        texture_atlas->current_y += texture_atlas->last_row_added_height;
+    return compacted || tgui_array_size(&texture_atlas->pages) != old_pages_count;
+}
 
-        texture_atlas->last_row_added_height = new_row_height;
+tgui_b32 tgui_texture_atlas_update_texture(TGuiTextureAtlas *texture_atlas, struct TGuiGfxBackend *gfx, tgui_b32 allow_compacted) {
 
+    if(!state.default_texture) return false;
+    if(texture_atlas->compacted && !allow_compacted) return false;
+
+    TGuiBitmap *bitmap = &texture_atlas->bitmap;
+    tgui_u32 pages_count = tgui_array_size(&texture_atlas->pages);
+    tgui_u64 page_texels = (tgui_u64)TGUI_TEXTURE_ATLAS_PAGE_SIZE * TGUI_TEXTURE_ATLAS_PAGE_SIZE;
+    
+    tgui_b32 dirty = false;
+    for(tgui_u32 i = 0; i < pages_count; ++i) {
+        dirty |= !tgui_rect_invalid(tgui_array_get_ptr(&texture_atlas->pages, i)->dirty_rect);
     }
+    
+    tgui_b32 pages_changed = texture_atlas->texture_pages_count != pages_count;
+    if(!dirty && !pages_changed) return false;
 
-    texture_atlas_bitmap = &texture_atlas->bitmap;
+    for(tgui_u32 i = 0; i < pages_count; ++i) {
 
-    texture->dim = tgui_rect_from_wh(texture_atlas->current_x, texture_atlas->current_y, bitmap->width, bitmap->height);
+        TGuiTextureAtlasPage *page = tgui_array_get_ptr(&texture_atlas->pages, i);
+        if(tgui_rect_invalid(page->dirty_rect)) continue;
 
-    TGuiPainter painter;
-    TGuiRectangle texture_atlas_rect = tgui_rect_from_wh(0, 0,texture_atlas_bitmap->width, texture_atlas_bitmap->height);
-    tgui_painter_start(&painter, TGUI_PAINTER_TYPE_SOFTWARE, texture_atlas_rect, 0, texture_atlas_bitmap->pixels, NULL);
+        if(!pages_changed && gfx->update_texture) {
+            TGuiRectangle rect = page->dirty_rect;
+            tgui_u32 *data = bitmap->pixels + i*page_texels + (tgui_u64)rect.min_y*bitmap->width + rect.min_x;
+            gfx->update_texture(state.default_texture, i, data, bitmap->width, rect.min_x, rect.min_y, tgui_rect_width(rect), tgui_rect_height(rect));
+        }
+        page->dirty_rect = tgui_rect_set_invalid();
+    }
+
+    if(pages_changed || !gfx->update_texture) {
+        void *old_texture = state.default_texture;
+        state.default_texture = gfx->create_texture(bitmap->pixels, TGUI_TEXTURE_ATLAS_PAGE_SIZE, TGUI_TEXTURE_ATLAS_PAGE_SIZE, pages_count);
+        tgui_render_state_replace_texture(&state.render_state, old_texture, state.default_texture);
+        gfx->destroy_texture(old_texture);
+        texture_atlas->texture_pages_count = pages_count;
+    }
+
+    texture_atlas->compacted = false;
+
+    return true;
+}
+
+tgui_u32 tgui_texture_atlas_get_pages_count(TGuiTextureAtlas *texture_atlas) {
+    return tgui_array_size(&texture_atlas->pages);
+}
+
+tgui_b32 tgui_texture_atlas_is_over_budget(TGuiTextureAtlas *texture_atlas) {
+    return texture_atlas->over_budget;
+}
+
+tgui_f32 tgui_texture_atlas_get_efficiency(TGuiTextureAtlas *texture_atlas) {
     
-    tgui_painter_draw_bitmap_no_alpha(&painter, texture_atlas->current_x, texture_atlas->current_y, bitmap);
+    tgui_u64 atlas_area = (tgui_u64)TGUI_TEXTURE_ATLAS_PAGE_SIZE * TGUI_TEXTURE_ATLAS_PAGE_SIZE * tgui_array_size(&texture_atlas->pages);
+    if(atlas_area == 0) return 0.0f;
     
-    texture_atlas->current_x += bitmap->width + TGUI_TEXTURE_ATLAS_DEFAULT_PADDING; 
+    tgui_u64 used_area = 0;
+    for(tgui_u32 i = 0; i < tgui_array_size(&texture_atlas->textures); ++i) {
+        TGuiTexture *texture = tgui_array_get_ptr(&texture_atlas->textures, i);
+        if(!tgui_rect_invalid(texture->dim)) {
+            used_area += (tgui_u64)tgui_rect_width(texture->dim) * tgui_rect_height(texture->dim);
+        }
+    }
 
+    return (tgui_f32)((tgui_f64)used_area / (tgui_f64)atlas_area);
 }
 
-void tgui_texture_atlas_generate_atlas(void) {
-    TGuiTextureAtlas *texture_atlas = state.default_texture_atlas;
+/* ----------------------------- */
+/*        TGui Glyph Atlas       */
+/* ----------------------------- */
 
-    texture_atlas_sort_textures_per_height(texture_atlas);
+void tgui_glyph_atlas_initialize(TGuiGlyphAtlas *glyph_atlas) {
+    
+    tgui_arena_initialize(&glyph_atlas->arena, 0, TGUI_ARENA_TYPE_VIRTUAL);
 
-    for(tgui_u32 i = 0; i < tgui_array_size(&texture_atlas->textures); ++i) {
+    glyph_atlas->width  = TGUI_GLYPH_ATLAS_WIDTH;
+    glyph_atlas->height = TGUI_GLYPH_ATLAS_START_HEIGHT;
+    glyph_atlas->pixels = tgui_arena_alloc(&glyph_atlas->arena, glyph_atlas->width*glyph_atlas->height, 1);
+    memset(glyph_atlas->pixels, 0, glyph_atlas->width*glyph_atlas->height);
+    
+    glyph_atlas->pixels[0] = 0xff;
+    glyph_atlas->current_x = 1 + TGUI_GLYPH_ATLAS_PADDING;
+    glyph_atlas->current_y = 0;
+    glyph_atlas->row_height = 1 + TGUI_GLYPH_ATLAS_PADDING;
+
+    glyph_atlas->texture = NULL;
+    glyph_atlas->texture_width = 0;
+    glyph_atlas->texture_height = 0;
+    glyph_atlas->texel_u = 0.0f;
+    glyph_atlas->texel_v = 0.0f;
+    glyph_atlas->dirty_rect = tgui_rect_from_wh(0, 0, glyph_atlas->width, glyph_atlas->height);
+}
+
+void tgui_glyph_atlas_terminate(TGuiGlyphAtlas *glyph_atlas, struct TGuiGfxBackend *gfx) {
+    if(glyph_atlas->texture) {
+        gfx->destroy_texture(glyph_atlas->texture);
+    }
+    tgui_arena_terminate(&glyph_atlas->arena);
+    memset(glyph_atlas, 0, sizeof(TGuiGlyphAtlas));
+}
+
+/* NOTE: The atlas is the only allocation of its virtual arena so growing it never moves the pixels */
+static void glyph_atlas_grow(TGuiGlyphAtlas *glyph_atlas, tgui_u32 min_height) {
+    
+    tgui_u32 new_height = glyph_atlas->height;
+    while(new_height < min_height) new_height += TGUI_GLYPH_ATLAS_GROW_HEIGHT;
+    
+    tgui_u64 grow_size = (tgui_u64)glyph_atlas->width * (new_height - glyph_atlas->height);
+    tgui_u8 *grow_pixels = tgui_arena_alloc(&glyph_atlas->arena, grow_size, 1);
+    TGUI_ASSERT(grow_pixels == glyph_atlas->pixels + glyph_atlas->width*glyph_atlas->height); (void)grow_pixels;
+    memset(grow_pixels, 0, grow_size);
+
+    glyph_atlas->height = new_height;
+}
+
+static TGuiRectangle glyph_atlas_insert(TGuiGlyphAtlas *glyph_atlas, tgui_u8 *coverage, tgui_u32 stride, tgui_u32 w, tgui_u32 h) {
+    
+    if(w == 0 || h == 0) return tgui_rect_set_invalid();
+    TGUI_ASSERT(w + TGUI_GLYPH_ATLAS_PADDING <= glyph_atlas->width);
 
-        TGuiTextureBucket *bucket = tgui_array_get_ptr(&texture_atlas->textures, i);
-        TGuiTexture *texture = bucket->texture;
-        //printf("%d) bitmap height: %d\n", (i + 1), texture->bitmap->height);
+    if(glyph_atlas->current_x + w + TGUI_GLYPH_ATLAS_PADDING > glyph_atlas->width) {
+        glyph_atlas->current_x = 0;
+        glyph_atlas->current_y += glyph_atlas->row_height;
+        glyph_atlas->row_height = 0;
+    }
+    
+    glyph_atlas->row_height = TGUI_MAX(glyph_atlas->row_height, h + TGUI_GLYPH_ATLAS_PADDING);
+    if(glyph_atlas->current_y + glyph_atlas->row_height > glyph_atlas->height) {
+        glyph_atlas_grow(glyph_atlas, glyph_atlas->current_y + glyph_atlas->row_height);
+    }
+
+    TGuiRectangle result = tgui_rect_from_wh(glyph_atlas->current_x, glyph_atlas->current_y, w, h);
+
+    tgui_u8 *des_row = glyph_atlas->pixels + result.min_y*glyph_atlas->width + result.min_x;
+    for(tgui_u32 y = 0; y < h; ++y) {
+        memcpy(des_row, coverage + (tgui_u64)y*stride, w);
+        des_row += glyph_atlas->width;
+    }
+
+    glyph_atlas->current_x += w + TGUI_GLYPH_ATLAS_PADDING;
+    glyph_atlas->dirty_rect = dirty_rect_add(glyph_atlas->dirty_rect, result);
+
+    return result;
+}
+
+TGuiRectangle tgui_glyph_atlas_insert(TGuiGlyphAtlas *glyph_atlas, tgui_u8 *coverage, tgui_u32 w, tgui_u32 h) {
+    return glyph_atlas_insert(glyph_atlas, coverage, w, w, h);
+}
+
+TGuiRectangle tgui_glyph_atlas_copy(TGuiGlyphAtlas *glyph_atlas, TGuiGlyphAtlas *source, TGuiRectangle rect) {
+    if(tgui_rect_invalid(rect)) return rect;
+    tgui_u8 *coverage = source->pixels + (tgui_u64)rect.min_y*source->width + rect.min_x;
+    return glyph_atlas_insert(glyph_atlas, coverage, source->width, tgui_rect_width(rect), tgui_rect_height(rect));
+}
+
+void tgui_glyph_atlas_restore(TGuiGlyphAtlas *glyph_atlas, tgui_u8 *pixels, tgui_u32 height, tgui_u32 current_x, tgui_u32 current_y, tgui_u32 row_height) {
+    
+    TGUI_ASSERT(current_x <= glyph_atlas->width && current_y + row_height <= height);
+    if(height > glyph_atlas->height) {
+        glyph_atlas_grow(glyph_atlas, height);
+    }
+
+    memcpy(glyph_atlas->pixels, pixels, (tgui_u64)glyph_atlas->width*height);
+    memset(glyph_atlas->pixels + (tgui_u64)glyph_atlas->width*height, 0, (tgui_u64)glyph_atlas->width*(glyph_atlas->height - height));
+    
+    glyph_atlas->current_x = current_x;
+    glyph_atlas->current_y = current_y;
+    glyph_atlas->row_height = row_height;
+    glyph_atlas->dirty_rect = tgui_rect_from_wh(0, 0, glyph_atlas->width, glyph_atlas->height);
+}
+
+tgui_b32 tgui_glyph_atlas_update_texture(TGuiGlyphAtlas *glyph_atlas, struct TGuiGfxBackend *gfx, tgui_b32 allow_resize) {
+    
+    if(tgui_rect_invalid(glyph_atlas->dirty_rect)) return false;
+
+    tgui_b32 resized = (glyph_atlas->texture_width != glyph_atlas->width) || (glyph_atlas->texture_height != glyph_atlas->height);
+    if(glyph_atlas->texture && resized && !allow_resize) return false;
+
+    if(glyph_atlas->texture && !resized && gfx->update_texture_r8) {
+        TGuiRectangle rect = glyph_atlas->dirty_rect;
+        tgui_u8 *data = glyph_atlas->pixels + (tgui_u64)rect.min_y*glyph_atlas->width + rect.min_x;
+        gfx->update_texture_r8(glyph_atlas->texture, data, glyph_atlas->width, rect.min_x, rect.min_y, tgui_rect_width(rect), tgui_rect_height(rect));
+    } else {
+        void *old_texture = glyph_atlas->texture;
+        glyph_atlas->texture = gfx->create_texture_r8(glyph_atlas->pixels, glyph_atlas->width, glyph_atlas->height);
         
-        texture_atlas_insert(texture_atlas, texture);
+        if(old_texture) {
+            tgui_render_state_replace_texture(&state.render_state, old_texture, glyph_atlas->texture);
+            gfx->destroy_texture(old_texture);
+        }
     }
+    glyph_atlas->texture_width = glyph_atlas->width;
+    glyph_atlas->texture_height = glyph_atlas->height;
+    glyph_atlas->texel_u = 1.0f / (tgui_f32)glyph_atlas->width;
+    glyph_atlas->texel_v = 1.0f / (tgui_f32)glyph_atlas->height;
+    glyph_atlas->dirty_rect = tgui_rect_set_invalid();
 
-    state.default_texture = state.render_state.gfx->create_texture(texture_atlas->bitmap.pixels, texture_atlas->bitmap.width, texture_atlas->bitmap.height);
+    return true;
 }
 
-tgui_u32 tgui_texture_atlas_get_width(TGuiTextureAtlas *texture_atlas) {
-    return texture_atlas->bitmap.width;
+tgui_f32 tgui_glyph_atlas_sample_sdf(TGuiGlyphAtlas *glyph_atlas, TGuiRectangle rect, tgui_f32 x, tgui_f32 y) {
+
+    x = TGUI_CLAMP(x, (tgui_f32)rect.min_x, (tgui_f32)rect.max_x);
+    y = TGUI_CLAMP(y, (tgui_f32)rect.min_y, (tgui_f32)rect.max_y);
+
+    tgui_s32 x0 = (tgui_s32)x;
+    tgui_s32 y0 = (tgui_s32)y;
+    tgui_s32 x1 = TGUI_MIN(x0 + 1, rect.max_x);
+    tgui_s32 y1 = TGUI_MIN(y0 + 1, rect.max_y);
+    
+    tgui_f32 tx = x - (tgui_f32)x0;
+    tgui_f32 ty = y - (tgui_f32)y0;
+
+    tgui_u8 *row0 = glyph_atlas->pixels + y0 * glyph_atlas->width;
+    tgui_u8 *row1 = glyph_atlas->pixels + y1 * glyph_atlas->width;
+
+    tgui_f32 top    = (tgui_f32)row0[x0] + ((tgui_f32)row0[x1] - (tgui_f32)row0[x0]) * tx;
+    tgui_f32 bottom = (tgui_f32)row1[x0] + ((tgui_f32)row1[x1] - (tgui_f32)row1[x0]) * tx;
+
+    return top + (bottom - top) * ty;
 }
 
-tgui_u32 tgui_texture_atlas_get_height(TGuiTextureAtlas *texture_atlas) {
-    return texture_atlas->bitmap.height;
+tgui_u8 tgui_sdf_coverage(tgui_f32 value, tgui_f32 texels_per_pixel) {
+    
+    tgui_f32 value_per_pixel = TGUI_SDF_DISTANCE_SCALE * TGUI_MAX(texels_per_pixel, 0.0001f);
+    tgui_f32 coverage = (value - ((tgui_f32)TGUI_SDF_ON_EDGE - 0.5f)) / value_per_pixel + 0.5f;
+    coverage = TGUI_CLAMP(coverage, 0.0f, 1.0f);
+
+    return (tgui_u8)(coverage * 255.0f + 0.5f);
 }
 
 /* ----------------------------------- */
@@ -189,9 +882,13 @@ tgui_u32 tgui_texture_atlas_get_height(TGuiTextureAtlas *texture_atlas) {
 void tgui_render_buffer_initialize(TGuiRenderBuffer *render_buffer) {
 
     tgui_array_initialize(&render_buffer->vertex_buffer);
-    tgui_array_initialize(&render_buffer->index_buffer);
+    tgui_array_initialize(&render_buffer->instance_buffer);
+    tgui_array_initialize(&render_buffer->draw_commands);
 
     render_buffer->program = NULL;
+    render_buffer->program_instanced = NULL;
+    render_buffer->program_sdf = NULL;
+    render_buffer->program_sdf_instanced = NULL;
     render_buffer->texture = NULL;
     render_buffer->texture_atlas = NULL;
 
@@ -199,26 +896,84 @@ void tgui_render_buffer_initialize(TGuiRenderBuffer *render_buffer) {
 
 void tgui_render_buffer_terminate(TGuiRenderBuffer *render_buffer) {
     tgui_array_terminate(&render_buffer->vertex_buffer);
-    tgui_array_terminate(&render_buffer->index_buffer);
+    tgui_array_terminate(&render_buffer->instance_buffer);
+    tgui_array_terminate(&render_buffer->draw_commands);
 }
 
 void tgui_render_buffer_clear(TGuiRenderBuffer *render_buffer) {
     tgui_array_clear(&render_buffer->vertex_buffer);
-    tgui_array_clear(&render_buffer->index_buffer);
+    tgui_array_clear(&render_buffer->instance_buffer);
+    tgui_array_clear(&render_buffer->draw_commands);
 }
 
 void tgui_render_buffer_set_program(TGuiRenderBuffer *render_buffer, void *program) {
     render_buffer->program = program;
 }
 
+void tgui_render_buffer_set_program_instanced(TGuiRenderBuffer *render_buffer, void *program) {
+    render_buffer->program_instanced = program;
+}
+
+void tgui_render_buffer_set_program_sdf(TGuiRenderBuffer *render_buffer, void *program) {
+    render_buffer->program_sdf = program;
+}
+
+void tgui_render_buffer_set_program_sdf_instanced(TGuiRenderBuffer *render_buffer, void *program) {
+    render_buffer->program_sdf_instanced = program;
+}
+
 void tgui_render_buffer_set_texture(TGuiRenderBuffer *render_buffer, void *texture) {
     render_buffer->texture = texture;
 }
 
+static void render_buffer_replace_texture(TGuiRenderBuffer *render_buffer, void *old_texture, void *new_texture) {
+    
+    if(render_buffer->texture == old_texture) render_buffer->texture = new_texture;
+    
+    for(tgui_u32 i = 0; i < tgui_array_size(&render_buffer->draw_commands); ++i) {
+        TGuiDrawCommand *command = tgui_array_get_ptr(&render_buffer->draw_commands, i);
+        if(command->texture == old_texture) command->texture = new_texture;
+    }
+}
+
 void tgui_render_buffer_set_texture_atlas(TGuiRenderBuffer *render_buffer, TGuiTextureAtlas *texture_atlas) {
     render_buffer->texture_atlas = texture_atlas;
 }
 
+/* NOTE: Must be called after every quad pushed to the render buffer, the quad is added to
+   the last draw command or a new one is started if the clip or the texture changed */
+void tgui_render_buffer_add_quads(TGuiRenderBuffer *render_buffer, TGuiRectangle clip, void *texture, tgui_b32 sdf, tgui_u32 quads_count) {
+    
+    TGuiDrawCommandArray *draw_commands = &render_buffer->draw_commands;
+    tgui_u32 draw_commands_count = tgui_array_size(draw_commands);
+    
+    TGuiDrawCommand *draw_command = NULL;
+    if(draw_commands_count > 0) {
+        draw_command = tgui_array_get_ptr(draw_commands, draw_commands_count - 1);
+    }
+
+    if(!texture) {
+        texture = draw_command ? draw_command->texture : render_buffer->texture;
+        sdf = draw_command ? draw_command->sdf : false;
+    }
+
+    if(!draw_command || !tgui_rect_equals(draw_command->clip, clip) || draw_command->texture != texture || draw_command->sdf != sdf) {
+        
+        tgui_u32 first_quad = draw_command ? draw_command->first_quad + draw_command->quads_count : 0;
+
+        /* NOTE: The draw commands are hashed, the padding must be zero */
+        draw_command = tgui_array_push(draw_commands);
+        memset(draw_command, 0, sizeof(TGuiDrawCommand));
+        draw_command->clip = clip;
+        draw_command->texture = texture;
+        draw_command->sdf = sdf;
+        draw_command->first_quad = first_quad;
+        draw_command->quads_count = 0;
+    }
+
+    draw_command->quads_count += quads_count;
+}
+
 /* ----------------------------------- */
 /*          TGui Render State          */
 /* ----------------------------------- */
@@ -230,8 +985,33 @@ void tgui_render_state_initialize(TGuiRenderState *render_state, struct TGuiGfxB
     
     tgui_array_initialize(&render_state->render_buffers_custom);
 
+    TGUI_ASSERT(gfx->max_quads_per_batch > 0);
+    TGUI_ASSERT(gfx->set_clip);
+
+    tgui_array_initialize(&render_state->quad_indices);
+    tgui_u32 batch_quads_count = TGUI_MIN(gfx->max_quads_per_batch, TGUI_MAX_QUADS_PER_U16_BATCH);
+    for(tgui_u32 i = 0; i < batch_quads_count; ++i) {
+        tgui_u16 *indices = tgui_array_push(&render_state->quad_indices);
+        tgui_array_push(&render_state->quad_indices);
+        tgui_array_push(&render_state->quad_indices);
+        tgui_array_push(&render_state->quad_indices);
+        tgui_array_push(&render_state->quad_indices);
+        tgui_array_push(&render_state->quad_indices);
+        
+        tgui_u16 vertex = (tgui_u16)(i * 4);
+        indices[0] = vertex + 0;
+        indices[1] = vertex + 1;
+        indices[2] = vertex + 2;
+        indices[3] = vertex + 2;
+        indices[4] = vertex + 3;
+        indices[5] = vertex + 0;
+    }
     render_state->gfx = gfx;
     render_state->current_render_buffer_custom_pushed_count = 0;
+
+    render_state->skip_unchanged_frames = false;
+    render_state->frame_changed = true;
+    render_state->frame_hash = 0;
 }
 
 void tgui_render_state_terminate(TGuiRenderState *render_state) {
@@ -241,6 +1021,7 @@ void tgui_render_state_terminate(TGuiRenderState *render_state) {
         tgui_render_buffer_terminate(render_buffer);
     }
     tgui_array_terminate(&render_state->render_buffers_custom);
+    tgui_array_terminate(&render_state->quad_indices);
 
     tgui_render_buffer_terminate(&render_state->render_buffer_tgui);
     tgui_render_buffer_terminate(&render_state->render_buffer_tgui_on_top);
@@ -261,6 +1042,17 @@ void tgui_render_state_clear_render_buffers(TGuiRenderState *render_state) {
 
 }
 
+void tgui_render_state_replace_texture(TGuiRenderState *render_state, void *old_texture, void *new_texture) {
+    
+    render_buffer_replace_texture(&render_state->render_buffer_tgui, old_texture, new_texture);
+    render_buffer_replace_texture(&render_state->render_buffer_tgui_on_top, old_texture, new_texture);
+
+    for(tgui_u32 i = 0; i < render_state->current_render_buffer_custom_pushed_count; ++i) {
+        TGuiRenderBuffer *render_buffer = tgui_array_get_ptr(&render_state->render_buffers_custom, i);
+        render_buffer_replace_texture(render_buffer, old_texture, new_texture);
+    }
+}
+
 TGuiRenderBuffer *tgui_render_state_push_render_buffer_custom(TGuiRenderState *render_state, void *program, void *texture, TGuiTextureAtlas *texture_atlas) {
     TGuiRenderBuffer *render_buffer = NULL;
     
@@ -273,6 +1065,9 @@ TGuiRenderBuffer *tgui_render_state_push_render_buffer_custom(TGuiRenderState *r
     ++render_state->current_render_buffer_custom_pushed_count;
 
     tgui_render_buffer_set_program(render_buffer, program);
+    tgui_render_buffer_set_program_instanced(render_buffer, NULL);
+    tgui_render_buffer_set_program_sdf(render_buffer, NULL);
+    tgui_render_buffer_set_program_sdf_instanced(render_buffer, NULL);
     tgui_render_buffer_set_texture(render_buffer, texture);
     tgui_render_buffer_set_texture_atlas(render_buffer, texture_atlas);
 
@@ -280,8 +1075,77 @@ TGuiRenderBuffer *tgui_render_state_push_render_buffer_custom(TGuiRenderState *r
     return render_buffer;
 }
 
+static void render_buffer_draw_instances(TGuiRenderState *render_state, TGuiRenderBuffer *render_buffer, TGuiDrawCommand *draw_command) {
+    
+    TGuiGfxBackend *gfx = render_state->gfx;
+
+    TGuiQuadInstance *instances = tgui_array_data(&render_buffer->instance_buffer);
+
+    void *program = draw_command->sdf ? render_buffer->program_sdf_instanced : render_buffer->program_instanced;
+
+    TGUI_ASSERT(gfx->draw_instances);
+    TGUI_ASSERT(program);
+
+    tgui_u32 last_instance = draw_command->first_quad + draw_command->quads_count;
+
+    for(tgui_u32 first_instance = draw_command->first_quad; first_instance < last_instance; first_instance += gfx->max_quads_per_batch) {
+        tgui_u32 batch_instances_count = TGUI_MIN(last_instance - first_instance, gfx->max_quads_per_batch);
+        gfx->draw_instances(program, draw_command->texture, draw_command->sdf, instances + first_instance, batch_instances_count);
+    }
+}
+
+static void render_buffer_draw_vertices(TGuiRenderState *render_state, TGuiRenderBuffer *render_buffer, TGuiDrawCommand *draw_command) {
+
+    TGuiGfxBackend *gfx = render_state->gfx;
+
+    TGuiVertex *vertices = tgui_array_data(&render_buffer->vertex_buffer);
+    tgui_u16 *indices = tgui_array_data(&render_state->quad_indices);
+    
+    void *program = draw_command->sdf ? render_buffer->program_sdf : render_buffer->program;
+    TGUI_ASSERT(program);
+
+    tgui_u32 max_batch_quads_count = tgui_array_size(&render_state->quad_indices) / 6;
+    tgui_u32 last_quad = draw_command->first_quad + draw_command->quads_count;
+
+    for(tgui_u32 first_quad = draw_command->first_quad; first_quad < last_quad; first_quad += max_batch_quads_count) {
+        
+        tgui_u32 batch_quads_count = TGUI_MIN(last_quad - first_quad, max_batch_quads_count);
+        
+        tgui_u32 base_vertex = first_quad * 4;
+        gfx->draw_buffers(program, draw_command->texture, draw_command->sdf, vertices + base_vertex, batch_quads_count * 4, indices, batch_quads_count * 6, sizeof(tgui_u16));
+    }
+}
+
 void tgui_render_buffer_draw(TGuiRenderState *render_state, TGuiRenderBuffer *render_buffer) {
-    render_state->gfx->draw_buffers(render_buffer->program, render_buffer->texture, &render_buffer->vertex_buffer, &render_buffer->index_buffer);
+
+    TGuiGfxBackend *gfx = render_state->gfx;
+
+    /* NOTE: The painter only emits quads (4 vertices or one instance), so the
+       buffers can be split at any quad boundary. A render buffer is only filled by one kind
+       of hardware painter */
+    tgui_u32 vertex_quads_count = tgui_array_size(&render_buffer->vertex_buffer) / 4;
+    tgui_u32 instance_quads_count = tgui_array_size(&render_buffer->instance_buffer);
+    TGUI_ASSERT(vertex_quads_count*4 == tgui_array_size(&render_buffer->vertex_buffer));
+    TGUI_ASSERT(vertex_quads_count == 0 || instance_quads_count == 0);
+
+    tgui_u32 draw_commands_count = tgui_array_size(&render_buffer->draw_commands);
+    if(draw_commands_count == 0) return;
+
+    tgui_b32 instanced = instance_quads_count > 0;
+
+    for(tgui_u32 i = 0; i < draw_commands_count; ++i) {
+
+        TGuiDrawCommand *draw_command = tgui_array_get_ptr(&render_buffer->draw_commands, i);
+        TGUI_ASSERT(draw_command->first_quad + draw_command->quads_count <= vertex_quads_count + instance_quads_count);
+
+        gfx->set_clip(draw_command->clip);
+        
+        if(instanced) {
+            render_buffer_draw_instances(render_state, render_buffer, draw_command);
+        } else {
+            render_buffer_draw_vertices(render_state, render_buffer, draw_command);
+        }
+    }
 }
 
 void tgui_render_state_draw_buffers(TGuiRenderState *render_state) {
@@ -299,3 +1163,41 @@ void tgui_render_state_draw_buffers(TGuiRenderState *render_state) {
 
     tgui_render_buffer_draw(render_state, &render_state->render_buffer_tgui_on_top);
 }
+
+static tgui_u64 render_buffer_hash(TGuiRenderBuffer *render_buffer, tgui_u64 hash) {
+    
+    void *handles[5] = { render_buffer->program, render_buffer->program_instanced, render_buffer->program_sdf, render_buffer->program_sdf_instanced, render_buffer->texture };
+    hash = tgui_hash_seed(handles, sizeof(handles), hash);
+
+    hash = tgui_hash_seed(tgui_array_data(&render_buffer->vertex_buffer), tgui_array_size(&render_buffer->vertex_buffer)*sizeof(TGuiVertex), hash);
+    hash = tgui_hash_seed(tgui_array_data(&render_buffer->instance_buffer), tgui_array_size(&render_buffer->instance_buffer)*sizeof(TGuiQuadInstance), hash);
+    hash = tgui_hash_seed(tgui_array_data(&render_buffer->draw_commands), tgui_array_size(&render_buffer->draw_commands)*sizeof(TGuiDrawCommand), hash);
+
+    return hash;
+}
+
+/* NOTE: Hash everything tgui_render_state_draw_buffers will submit, in the same order */
+void tgui_render_state_update_frame_changed(TGuiRenderState *render_state, tgui_u32 width, tgui_u32 height) {
+
+    if(!render_state->skip_unchanged_frames) {
+        render_state->frame_changed = true;
+        return;
+    }
+
+    tgui_u32 dimensions[2] = { width, height };
+    tgui_u64 hash = tgui_hash(dimensions, sizeof(dimensions));
+
+    for(tgui_u32 i = 0; i < render_state->current_render_buffer_custom_pushed_count; ++i) {
+        TGuiRenderBuffer *render_buffer = tgui_array_get_ptr(&render_state->render_buffers_custom, i);
+        hash = render_buffer_hash(render_buffer, hash);
+    }
+    
+    hash = render_buffer_hash(&render_state->render_buffer_tgui, hash);
+    hash = render_buffer_hash(&render_state->render_buffer_tgui_on_top, hash);
+
+    /* NOTE: 0 is reserved to force the next frame to be draw */
+    if(hash == 0) hash = 1;
+
+    render_state->frame_changed = (hash != render_state->frame_hash);
+    render_state->frame_hash = hash;
+}
@@ -8,14 +8,26 @@
 /*       TGui Bitmap       */
 /* ----------------------- */
 
+/* NOTE: Index of a texture in its texture atlas and the generation of the index, it stays valid
+   when the texture is evicted or moved by the atlas and until the bitmap is removed from the atlas.
+   The generation changes when the bitmap is removed so a handle is never valid for the bitmap that
+   reuses the index */
+typedef tgui_u32 TGuiTextureHandle;
+
+#define TGUI_TEXTURE_HANDLE_INVALID ((TGuiTextureHandle)-1)
+#define TGUI_TEXTURE_HANDLE_INDEX_BITS 20
+#define TGUI_TEXTURE_HANDLE_INDEX_MASK ((1u << TGUI_TEXTURE_HANDLE_INDEX_BITS) - 1)
+#define TGUI_TEXTURE_HANDLE_GENERATION_MASK ((TGuiTextureHandle)-1 >> TGUI_TEXTURE_HANDLE_INDEX_BITS)
+
 typedef struct TGuiBitmap {
     tgui_u32 *pixels;
     tgui_u32 width, height;
-    struct TGuiTexture *texture;
+    TGuiTextureHandle texture;
 } TGuiBitmap;
 
 TGuiBitmap tgui_bitmap_alloc_empty(TGuiArena *arena, tgui_u32 w, tgui_u32 h);
 
+/* NOTE: The copy is not in any texture atlas */
 TGuiBitmap tgui_bitmap_copy(TGuiArena *arena, TGuiBitmap *bitmap);
 
 /* ------------------------ */
@@ -23,33 +35,139 @@ TGuiBitmap tgui_bitmap_copy(TGuiArena *arena, TGuiBitmap *bitmap);
 /* ------------------------ */
 
 typedef struct TGuiTexture {
+    /* NOTE: Position of the texture in its page of the atlas, invalid while the texture is not
+       in the atlas */
     TGuiRectangle dim;
+    tgui_u32 page;
+    /* NOTE: NULL for the free textures of the atlas */
     TGuiBitmap *bitmap;
+    
+    /* NOTE: The dim normalized with the size of the page, updated when the texture is inserted
+       so the painter does not divide for every quad */
+    tgui_f32 min_u, min_v;
+    tgui_f32 max_u, max_v;
+
+    /* NOTE: Frame of the atlas in which the texture was last drawn */
+    tgui_u64 last_used_frame;
+    tgui_b32 pending;
+    /* NOTE: Generation of the handle of the bitmap */
+    tgui_u32 generation;
 } TGuiTexture;
 
-typedef struct TGuiTextureBucket {
-    TGuiTexture *texture;
-} TGuiTextureBucket;
-
-TGuiArray(TGuiTextureBucket, TGuiTextureArray);
+TGuiArray(TGuiTexture, TGuiTextureArray);
+TGuiArray(TGuiTexture *, TGuiTexturePtrArray);
+TGuiArray(tgui_u32, TGuiU32Array);
+TGuiArray(tgui_u64, TGuiU64Array);
 
-#define TGUI_TEXTURE_ATLAS_START_WIDTH 1024
+#define TGUI_TEXTURE_ATLAS_PAGE_SIZE 2048
 #define TGUI_TEXTURE_ATLAS_DEFAULT_PADDING 4
+/* NOTE: The page is stored in the alpha byte of the vertex color */
+#define TGUI_TEXTURE_ATLAS_MAX_PAGES 256
+#define TGUI_TEXTURE_ATLAS_DEFAULT_MAX_PAGES 4
+/* NOTE: Part of the area of the pages filled when the atlas is compacted, the rest is left for
+   the textures drawn after the compaction */
+#define TGUI_TEXTURE_ATLAS_COMPACT_FILL 0.75f
+
+/* ----------------------------- */
+/*       TGui Skyline Packer     */
+/* ----------------------------- */
+
+/* NOTE: Bottom left skyline packer, the skyline is the top edge of the packed rects from left to
+   right. A rect goes where its top is the lowest, ties go to the narrowest segment */
+
+typedef struct TGuiSkylineNode {
+    tgui_u32 x, y;
+    tgui_u32 width;
+} TGuiSkylineNode;
+
+typedef struct TGuiSkyline {
+    tgui_u32 width, height;
+
+    /* NOTE: Every node is at least one pixel wide so there are never more than width nodes */
+    TGuiSkylineNode *nodes;
+    tgui_u32 nodes_count;
+
+    TGuiArena arena;
+} TGuiSkyline;
+
+void tgui_skyline_initialize(TGuiSkyline *skyline, tgui_u32 width, tgui_u32 height);
+
+void tgui_skyline_terminate(TGuiSkyline *skyline);
+
+/* NOTE: Remove all the rects and change the size */
+void tgui_skyline_reset(TGuiSkyline *skyline, tgui_u32 width, tgui_u32 height);
+
+/* NOTE: The packed rects keep their position, only the free space grows */
+void tgui_skyline_set_height(TGuiSkyline *skyline, tgui_u32 height);
+
+/* NOTE: Returns false if a w*h rect does not fit in the skyline */
+tgui_b32 tgui_skyline_insert(TGuiSkyline *skyline, tgui_u32 w, tgui_u32 h, tgui_u32 *x, tgui_u32 *y);
+
+/* NOTE: Height of the highest packed rect */
+tgui_u32 tgui_skyline_get_used_height(TGuiSkyline *skyline);
 
 /* ----------------------------- */
 /*       TGui Texture Atlas      */
 /* ----------------------------- */
 
+struct TGuiGfxBackend;
+
+/* NOTE: The atlas is made of square pages of TGUI_TEXTURE_ATLAS_PAGE_SIZE, uploaded as the layers
+   of one texture array so quads of every page are drawn in the same batch. The textures are packed
+   with a skyline packer per page, sorted by height when the atlas is generated. The atlas grows
+   adding pages so the texture coordinates already pushed never change.
+
+   When max_pages are full the atlas is compacted: the most recently drawn textures are packed again
+   from their bitmaps and the least recently used ones are evicted. An evicted texture keeps its
+   handle and goes back to the atlas the next time it is drawn. The textures drawn in the frame
+   of the compaction are never evicted, if they alone do not fit in max_pages the atlas goes over
+   budget and adds the pages they need. The pages over the budget are dropped by the first
+   compaction after the textures drawn in a frame fit in max_pages again */
+
+typedef struct TGuiTextureAtlasPage {
+    TGuiSkyline skyline;
+    /* NOTE: Pixels of the page changed since the last upload */
+    TGuiRectangle dirty_rect;
+} TGuiTextureAtlasPage;
+
+TGuiArray(TGuiTextureAtlasPage, TGuiTextureAtlasPageArray);
+
 typedef struct TGuiTextureAtlas {
     
+    /* NOTE: The pages one below the other, the page i starts at the row i*TGUI_TEXTURE_ATLAS_PAGE_SIZE */
     TGuiBitmap bitmap;
 
-    tgui_u32 current_x;
-    tgui_u32 current_y;
-    tgui_u32 last_row_added_height;
+    TGuiTextureAtlasPageArray pages;
 
     TGuiArena arena;
+
+    /* NOTE: Indexed by the index of TGuiTextureHandle, the indices of the removed bitmaps are reused */
     TGuiTextureArray textures;
+    TGuiU32Array free_textures;
+
+    /* NOTE: Textures added after the atlas was generated go to the free space of the pages, the
+       ones that do not fit and the evicted ones that are drawn wait in pending_textures until the
+       end of the frame. Indices of the textures */
+    TGuiU32Array pending_textures;
+    tgui_b32 generated;
+
+    tgui_u64 frame;
+    tgui_u32 max_pages;
+    /* NOTE: The atlas has more than max_pages since the last compaction */
+    tgui_b32 over_budget;
+    /* NOTE: Area of the textures drawn in the last compaction that did not fit in max_pages */
+    tgui_u64 over_budget_area;
+
+    /* NOTE: Used to sort the textures when they are packed */
+    TGuiTexturePtrArray pack_textures;
+
+    /* NOTE: Pages of the uploaded texture, only the dirty rects are uploaded while it does not change */
+    tgui_u32 texture_pages_count;
+    /* NOTE: The textures moved since the last upload */
+    tgui_b32 compacted;
+
+    /* NOTE: Used to copy all the textures in parallel when the atlas is generated or compacted */
+    struct TGuiTileBinner *binner;
     
 } TGuiTextureAtlas;
 
@@ -57,26 +175,178 @@ void tgui_texture_atlas_initialize(TGuiTextureAtlas *texture_atlas);
 
 void tgui_texture_atlas_terminate(TGuiTextureAtlas *texture_atlas);
 
-void tgui_texture_atlas_add_bitmap(TGuiTextureAtlas *texture_atlas, TGuiBitmap *bitmap);
+/* NOTE: The bitmap has to stay alive until it is removed, the atlas copies it again when an evicted
+   texture is drawn */
+TGuiTextureHandle tgui_texture_atlas_add_bitmap(TGuiTextureAtlas *texture_atlas, TGuiBitmap *bitmap);
+
+/* NOTE: The space of the texture is reclaimed the next time the atlas is compacted, the handle of
+   the bitmap and its copies are not valid anymore */
+void tgui_texture_atlas_remove_bitmap(TGuiTextureAtlas *texture_atlas, TGuiBitmap *bitmap);
+
+/* NOTE: Mark the texture as used in this frame. Returns NULL if the texture is not in the atlas,
+   it is inserted at the end of the frame and can be drawn from the next one. Handles of removed
+   bitmaps return NULL and are never inserted */
+TGuiTexture *tgui_texture_atlas_use_texture(TGuiTextureAtlas *texture_atlas, TGuiTextureHandle handle);
+
+/* NOTE: The atlas is compacted instead of adding pages once it has max_pages */
+void tgui_texture_atlas_set_max_pages(TGuiTextureAtlas *texture_atlas, tgui_u32 max_pages);
 
 void tgui_texture_atlas_generate_atlas(void);
 
-tgui_u32 tgui_texture_atlas_get_width(TGuiTextureAtlas *texture_atlas);
+/* NOTE: Called once at the end of every frame. Insert the pending textures adding pages or
+   compacting the atlas if they do not fit. Returns true if pages were added or the textures were
+   moved */
+tgui_b32 tgui_texture_atlas_insert_pending(TGuiTextureAtlas *texture_atlas);
+
+/* NOTE: Upload the changes of the atlas to the default texture, the texture is created again with
+   all the pages when pages were added or dropped. With allow_compacted false it is not uploaded if the textures were
+   moved since the last upload. Returns true if the texture was uploaded */
+tgui_b32 tgui_texture_atlas_update_texture(TGuiTextureAtlas *texture_atlas, struct TGuiGfxBackend *gfx, tgui_b32 allow_compacted);
 
-tgui_u32 tgui_texture_atlas_get_height(TGuiTextureAtlas *texture_atlas);
+tgui_u32 tgui_texture_atlas_get_pages_count(TGuiTextureAtlas *texture_atlas);
+
+/* NOTE: True if the textures drawn in one frame did not fit in max_pages */
+tgui_b32 tgui_texture_atlas_is_over_budget(TGuiTextureAtlas *texture_atlas);
+
+/* NOTE: Area of the textures over the area of the pages */
+tgui_f32 tgui_texture_atlas_get_efficiency(TGuiTextureAtlas *texture_atlas);
+
+/* ----------------------------- */
+/*        TGui Glyph Atlas       */
+/* ----------------------------- */
+
+/* NOTE: Glyphs coverage is kept in its own 8 bits per pixel atlas, the backend uploads it with
+   create_texture_r8 and samples it as (1, 1, 1, coverage). The width is fixed and the atlas grows
+   down in place. The texel (0, 0) is full coverage so solid quads can use this texture too */
+
+#define TGUI_GLYPH_ATLAS_WIDTH 1024
+#define TGUI_GLYPH_ATLAS_START_HEIGHT 256
+#define TGUI_GLYPH_ATLAS_GROW_HEIGHT 256
+#define TGUI_GLYPH_ATLAS_PADDING 1
+
+typedef struct TGuiGlyphAtlas {
+    
+    tgui_u8 *pixels;
+    tgui_u32 width, height;
+
+    tgui_u32 current_x;
+    tgui_u32 current_y;
+    tgui_u32 row_height;
+
+    TGuiArena arena;
+    
+    /* NOTE: Size of the uploaded texture, texture coordinates are normalized with it and
+       glyphs outside of it are not drawn until the next upload */
+    void *texture;
+    tgui_u32 texture_width, texture_height;
+    /* NOTE: Size of one texel in normalized texture coordinates of the uploaded texture */
+    tgui_f32 texel_u, texel_v;
+    /* NOTE: Pixels changed since the last upload */
+    TGuiRectangle dirty_rect;
+
+} TGuiGlyphAtlas;
+
+void tgui_glyph_atlas_initialize(TGuiGlyphAtlas *glyph_atlas);
+
+void tgui_glyph_atlas_terminate(TGuiGlyphAtlas *glyph_atlas, struct TGuiGfxBackend *gfx);
+
+/* NOTE: Copy the coverage (w*h bytes) in the atlas and return where it was stored */
+TGuiRectangle tgui_glyph_atlas_insert(TGuiGlyphAtlas *glyph_atlas, tgui_u8 *coverage, tgui_u32 w, tgui_u32 h);
+
+/* NOTE: Insert the rect of the source atlas in the atlas, used to rebuild an atlas without the glyphs
+   that are not needed anymore */
+TGuiRectangle tgui_glyph_atlas_copy(TGuiGlyphAtlas *glyph_atlas, TGuiGlyphAtlas *source, TGuiRectangle rect);
+
+/* NOTE: Replace the content of the atlas with the first height rows of pixels and the packing
+   state of another atlas with the same width, used to restore an atlas saved in a file */
+void tgui_glyph_atlas_restore(TGuiGlyphAtlas *glyph_atlas, tgui_u8 *pixels, tgui_u32 height, tgui_u32 current_x, tgui_u32 current_y, tgui_u32 row_height);
+
+/* NOTE: Upload the atlas if it changed, with allow_resize false it is not uploaded if the size
+   changed since the last upload. Returns true if the texture was uploaded */
+tgui_b32 tgui_glyph_atlas_update_texture(TGuiGlyphAtlas *glyph_atlas, struct TGuiGfxBackend *gfx, tgui_b32 allow_resize);
+
+/* NOTE: A glyph atlas can also store signed distance fields, the value on the outline is
+   TGUI_SDF_ON_EDGE and it changes TGUI_SDF_DISTANCE_SCALE per texel, so the field reaches 0
+   TGUI_SDF_PADDING texels outside of the glyph. They are scaled with bilinear filtering and
+   the pixels above the edge are inside, smoothed over one destination pixel */
+
+#define TGUI_SDF_PADDING 4
+#define TGUI_SDF_ON_EDGE 128
+#define TGUI_SDF_DISTANCE_SCALE ((tgui_f32)TGUI_SDF_ON_EDGE / (tgui_f32)TGUI_SDF_PADDING)
+
+/* NOTE: Bilinear sample of the field at (x, y) in texels, clamped to the rect */
+tgui_f32 tgui_glyph_atlas_sample_sdf(TGuiGlyphAtlas *glyph_atlas, TGuiRectangle rect, tgui_f32 x, tgui_f32 y);
+
+/* NOTE: Coverage in [0, 255] of a field value when one destination pixel covers texels_per_pixel texels */
+tgui_u8 tgui_sdf_coverage(tgui_f32 value, tgui_f32 texels_per_pixel);
 
 /* ----------------------------- */
 /*          TGui Vertext         */
 /* ----------------------------- */
 
+/* NOTE: Define TGUI_PACKED_VERTEX to use the 12 bytes vertex format, int16 positions,
+   unorm16 uvs and a 0xPPRRGGBB color that the backend reads as normalized BGRA bytes. The
+   colors are always opaque so the alpha byte stores the page of the texture array */
+
+#ifdef TGUI_PACKED_VERTEX
+
+typedef struct TGuiVertex {
+    tgui_s16 x, y;
+    tgui_u16 u, v;
+    tgui_u32 color;
+} TGuiVertex;
+
+#else
+
 typedef struct TGuiVertex {
     float x, y;
     float u, v;
     float r, g, b;
+    float page;
 } TGuiVertex;
 
+#endif
+
 TGuiArray(TGuiVertex, TGuiVertexArray);
-TGuiArray(tgui_u32, TGuiU32Array);
+TGuiArray(tgui_u16, TGuiU16Array);
+
+/* NOTE: Batches of up to this many quads have at most 0x10000 vertices, so they are drawn with
+   16 bits indices */
+#define TGUI_MAX_QUADS_PER_U16_BATCH (0x10000 / 4)
+
+/* ----------------------------- */
+/*       TGui Quad Instance      */
+/* ----------------------------- */
+
+/* NOTE: Instanced mode emits one of this per quad instead of 4 vertices and 6 indices,
+   the rect is in pixels with max exclusive, uvs are unorm16 and the backend expands
+   the 4 corners in the vertex shader. The color is 0xPPRRGGBB like the packed vertex */
+
+typedef struct TGuiQuadInstance {
+    tgui_s16 min_x, min_y, max_x, max_y;
+    tgui_u16 min_u, min_v, max_u, max_v;
+    tgui_u32 color;
+} TGuiQuadInstance;
+
+TGuiArray(TGuiQuadInstance, TGuiQuadInstanceArray);
+
+/* ----------------------------------- */
+/*          TGui Draw Command          */
+/* ----------------------------------- */
+
+/* NOTE: Every quad of a render buffer belongs to a draw command, the backend applies
+   the clip (inclusive, in pixels from the top left corner) with a scissor test */
+
+typedef struct TGuiDrawCommand {
+    TGuiRectangle clip;
+    void *texture;
+    /* NOTE: The texture is a signed distance field, drawn with the sdf programs */
+    tgui_b32 sdf;
+    tgui_u32 first_quad;
+    tgui_u32 quads_count;
+} TGuiDrawCommand;
+
+TGuiArray(TGuiDrawCommand, TGuiDrawCommandArray);
 
 /* ----------------------------------- */
 /*          TGui Render Buffer         */
@@ -87,12 +357,18 @@ struct TGuiRenderState;
 typedef struct TGuiRenderBuffer {
 
     void *program;
+    void *program_instanced;
+    void *program_sdf;
+    void *program_sdf_instanced;
     void *texture;
     TGuiTextureAtlas *texture_atlas;
     
+    /* NOTE: 4 vertices per quad, drawn with the quad indices of the render state */
     TGuiVertexArray vertex_buffer;
-    TGuiU32Array    index_buffer;
     
+    TGuiQuadInstanceArray instance_buffer;
+
+    TGuiDrawCommandArray draw_commands;
 
 } TGuiRenderBuffer;
 
@@ -104,10 +380,21 @@ void tgui_render_buffer_clear(TGuiRenderBuffer *render_buffer);
 
 void tgui_render_buffer_set_program(TGuiRenderBuffer *render_buffer, void *program);
 
+void tgui_render_buffer_set_program_instanced(TGuiRenderBuffer *render_buffer, void *program);
+
+void tgui_render_buffer_set_program_sdf(TGuiRenderBuffer *render_buffer, void *program);
+
+void tgui_render_buffer_set_program_sdf_instanced(TGuiRenderBuffer *render_buffer, void *program);
+
 void tgui_render_buffer_set_texture(TGuiRenderBuffer *render_buffer, void *texture);
 
 void tgui_render_buffer_set_texture_atlas(TGuiRenderBuffer *render_buffer, TGuiTextureAtlas *texture_atlas);
 
+/* NOTE: Add quads_count quads already pushed in the vertex or instance buffer to the draw commands.
+   texture NULL is a solid quad, it keeps the texture and the sdf mode of the current draw command
+   because every texture used by tgui has a white texel at (0, 0), a full value is inside for sdf textures */
+void tgui_render_buffer_add_quads(TGuiRenderBuffer *render_buffer, TGuiRectangle clip, void *texture, tgui_b32 sdf, tgui_u32 quads_count);
+
 void tgui_render_buffer_draw(struct TGuiRenderState *render_state, TGuiRenderBuffer *render_buffer);
 
 /* ----------------------------------- */
@@ -126,6 +413,14 @@ typedef struct TGuiRenderState {
     TGuiRenderBufferArray render_buffers_custom;
     tgui_u32 current_render_buffer_custom_pushed_count;
 
+    /* NOTE: Indices of the quads of a batch relative to its first vertex, they are the same for
+       every batch so they are built once */
+    TGuiU16Array quad_indices;
+
+    tgui_b32 skip_unchanged_frames;
+    tgui_b32 frame_changed;
+    tgui_u64 frame_hash;
+
 } TGuiRenderState;
 
 void tgui_render_state_initialize(TGuiRenderState *render_state, struct TGuiGfxBackend *gfx);
@@ -136,8 +431,13 @@ TGuiRenderBuffer *tgui_render_state_push_render_buffer_custom(TGuiRenderState *r
 
 void tgui_render_state_clear_render_buffers(TGuiRenderState *render_state);
 
+/* NOTE: Used when a texture is created again, the buffers and draw commands already pushed use the new one */
+void tgui_render_state_replace_texture(TGuiRenderState *render_state, void *old_texture, void *new_texture);
+
 void tgui_render_state_draw_buffers(TGuiRenderState *render_state);
 
+void tgui_render_state_update_frame_changed(TGuiRenderState *render_state, tgui_u32 width, tgui_u32 height);
+
 
 /* -------------------------------------------- */
 /*         TGui Platform specifyc backend       */
@@ -148,12 +448,30 @@ void tgui_render_state_draw_buffers(TGuiRenderState *render_state);
 typedef void *(*TGuiGfxCreateProgram) (char *vert, char *frag);
 typedef void (*TGuiGfxDestroyProgram) (void *program);
 
-typedef void *(*TGuiGfxCreateTexture) (tgui_u32 *data, tgui_u32 width, tgui_u32 height);
+/* NOTE: The textures are arrays of pages of width*height texels, the pages of data are one after the other */
+typedef void *(*TGuiGfxCreateTexture) (tgui_u32 *data, tgui_u32 width, tgui_u32 height, tgui_u32 pages);
+typedef void *(*TGuiGfxCreateTextureR8) (tgui_u8 *data, tgui_u32 width, tgui_u32 height);
 typedef void (*TGuiGfxDestroyTexture) (void *texture);
 
+/* NOTE: Replace the w*h rect at (x, y) of a page of the texture, data points to the first texel of
+   the rect and stride is the number of texels from one row of data to the next */
+typedef void (*TGuiGfxUpdateTexture) (void *texture, tgui_u32 page, tgui_u32 *data, tgui_u32 stride, tgui_u32 x, tgui_u32 y, tgui_u32 w, tgui_u32 h);
+typedef void (*TGuiGfxUpdateTextureR8) (void *texture, tgui_u8 *data, tgui_u32 stride, tgui_u32 x, tgui_u32 y, tgui_u32 w, tgui_u32 h);
+
 typedef void (*TGuiGfxSetProgramWidthAndHeight) (void *program, tgui_u32 width, tgui_u32 height);
 
-typedef void (*TGuiGfxDrawBuffers) (void *program, void *texutre, TGuiVertexArray *vertex_buffer, TGuiU32Array *index_buffer);
+typedef void (*TGuiGfxSetClip) (TGuiRectangle clip);
+
+/* NOTE: sdf is set when the texture is a signed distance field, the program is one of the sdf
+   programs then. Backends without shaders use it to pick how the texture is sampled */
+
+/* NOTE: index_size is the size in bytes of each index, 2 or 4. The indices are always the quad
+   indices of the render state, the same table of max_quads_per_batch quads (at most
+   TGUI_MAX_QUADS_PER_U16_BATCH) that never changes, so backends can upload it once and only copy
+   the vertices in each draw */
+typedef void (*TGuiGfxDrawBuffers) (void *program, void *texutre, tgui_b32 sdf, TGuiVertex *vertices, tgui_u32 vertices_count, void *indices, tgui_u32 indices_count, tgui_u32 index_size);
+
+typedef void (*TGuiGfxDrawInstances) (void *program, void *texutre, tgui_b32 sdf, TGuiQuadInstance *instances, tgui_u32 instances_count);
 
 
 typedef struct TGuiGfxBackend {
@@ -164,9 +482,26 @@ typedef struct TGuiGfxBackend {
     TGuiGfxCreateTexture  create_texture; 
     TGuiGfxDestroyTexture destroy_texture;
     
+    /* NOTE: One channel texture with one page, sampled as (1, 1, 1, r) */
+    TGuiGfxCreateTextureR8 create_texture_r8;
+
+    /* NOTE: Optional, backends that set them get only the changed rects of the atlases uploaded,
+       the others create the texture again */
+    TGuiGfxUpdateTexture update_texture;
+    TGuiGfxUpdateTextureR8 update_texture_r8;
+    
     TGuiGfxSetProgramWidthAndHeight set_program_width_and_height;
 
+    TGuiGfxSetClip set_clip;
+
     TGuiGfxDrawBuffers draw_buffers;
+    
+    /* NOTE: Optional, backends that set it get the instanced painter mode */
+    TGuiGfxDrawInstances draw_instances;
+
+    /* NOTE: Max number of quads the backend can draw in one call to draw_buffers or
+       draw_instances, bigger render buffers are split in batches of this size */
+    tgui_u32 max_quads_per_batch;
 
 } TGuiGfxBackend;
 
@@ -0,0 +1,476 @@
+#include "tgui_gfx_software.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* NOTE: There is no GPU limit to respect, the batch size only bounds the index scratch buffers */
+#define TGUI_SOFTWARE_MAX_QUADS_PER_BATCH 16384
+
+/* NOTE: The pages are one after the other in pixels */
+typedef struct TGuiSoftwareTexture {
+    tgui_u32 *pixels;
+    tgui_u32 width, height;
+    tgui_u32 pages;
+} TGuiSoftwareTexture;
+
+/* NOTE: The shaders are not used, the draws with sdf set sample the texture as a signed distance
+   field like shaders/quad_sdf.frag */
+typedef struct TGuiSoftwareProgram {
+    tgui_u32 width, height;
+} TGuiSoftwareProgram;
+
+typedef struct TGuiSoftwareBackend {
+
+    tgui_u32 *pixels;
+    tgui_u32 width, height;
+
+    TGuiRectangle clip;
+
+} TGuiSoftwareBackend;
+
+/* NOTE: Vertex with the attributes as the shaders see them, uvs normalized and color in [0, 255] */
+typedef struct TGuiSoftwareVertex {
+    tgui_f32 x, y;
+    tgui_f32 u, v;
+    tgui_f32 r, g, b;
+    tgui_u32 page;
+} TGuiSoftwareVertex;
+
+static TGuiSoftwareBackend software;
+
+static inline void software_fetch_vertex(TGuiSoftwareVertex *result, TGuiVertex *vertex) {
+#ifdef TGUI_PACKED_VERTEX
+    result->x = (tgui_f32)vertex->x;
+    result->y = (tgui_f32)vertex->y;
+    result->u = (tgui_f32)vertex->u / 65535.0f;
+    result->v = (tgui_f32)vertex->v / 65535.0f;
+    result->r = (tgui_f32)((vertex->color >> 16) & 0xff);
+    result->g = (tgui_f32)((vertex->color >>  8) & 0xff);
+    result->b = (tgui_f32)((vertex->color >>  0) & 0xff);
+    result->page = vertex->color >> 24;
+#else
+    result->x = vertex->x;
+    result->y = vertex->y;
+    result->u = vertex->u;
+    result->v = vertex->v;
+    result->r = vertex->r * 255.0f;
+    result->g = vertex->g * 255.0f;
+    result->b = vertex->b * 255.0f;
+    result->page = (tgui_u32)vertex->page;
+#endif
+}
+
+static inline tgui_u32 *software_texture_page(TGuiSoftwareTexture *texture, tgui_u32 page) {
+    TGUI_ASSERT(page < texture->pages);
+    return texture->pixels + (tgui_u64)page * texture->width * texture->height;
+}
+
+/* NOTE: Nearest filter with a transparent black border, same as the OpenGL backend textures.
+   Draws without texture sample white */
+static inline tgui_u32 software_texture_sample(TGuiSoftwareTexture *texture, tgui_u32 page, tgui_f32 u, tgui_f32 v) {
+
+    if(!texture) return 0xffffffff;
+
+    if(u < 0.0f || v < 0.0f) return 0;
+
+    tgui_u32 x = (tgui_u32)(u * (tgui_f32)texture->width);
+    tgui_u32 y = (tgui_u32)(v * (tgui_f32)texture->height);
+
+    if(x >= texture->width || y >= texture->height) return 0;
+
+    return software_texture_page(texture, page)[y * texture->width + x];
+}
+
+/* NOTE: Bilinear filter of the alpha with the texels clamped to the texture, the coverage
+   is white with alpha */
+static inline tgui_u32 software_texture_sample_sdf(TGuiSoftwareTexture *texture, tgui_u32 page, tgui_f32 u, tgui_f32 v, tgui_f32 texels_per_pixel) {
+
+    if(!texture) return 0xffffffff;
+
+    tgui_f32 x = u * (tgui_f32)texture->width  - 0.5f;
+    tgui_f32 y = v * (tgui_f32)texture->height - 0.5f;
+
+    tgui_f32 floor_x = floorf(x);
+    tgui_f32 floor_y = floorf(y);
+    tgui_f32 tx = x - floor_x;
+    tgui_f32 ty = y - floor_y;
+
+    tgui_s32 max_x = (tgui_s32)texture->width - 1;
+    tgui_s32 max_y = (tgui_s32)texture->height - 1;
+    tgui_s32 x0 = TGUI_CLAMP((tgui_s32)floor_x, 0, max_x);
+    tgui_s32 y0 = TGUI_CLAMP((tgui_s32)floor_y, 0, max_y);
+    tgui_s32 x1 = TGUI_CLAMP((tgui_s32)floor_x + 1, 0, max_x);
+    tgui_s32 y1 = TGUI_CLAMP((tgui_s32)floor_y + 1, 0, max_y);
+
+    tgui_u32 *pixels = software_texture_page(texture, page);
+    tgui_u32 *row0 = pixels + y0 * texture->width;
+    tgui_u32 *row1 = pixels + y1 * texture->width;
+
+    tgui_f32 d00 = (tgui_f32)(row0[x0] >> 24);
+    tgui_f32 d10 = (tgui_f32)(row0[x1] >> 24);
+    tgui_f32 d01 = (tgui_f32)(row1[x0] >> 24);
+    tgui_f32 d11 = (tgui_f32)(row1[x1] >> 24);
+
+    tgui_f32 top    = d00 + (d10 - d00) * tx;
+    tgui_f32 bottom = d01 + (d11 - d01) * tx;
+    tgui_u32 coverage = tgui_sdf_coverage(top + (bottom - top) * ty, texels_per_pixel);
+    
+    return (coverage << 24) | 0x00ffffff;
+}
+
+/* NOTE: fragment = texel * color, blended with src_alpha, one_minus_src_alpha */
+static inline void software_blend_pixel(tgui_u32 *pixel, tgui_u32 texel, tgui_u32 r, tgui_u32 g, tgui_u32 b) {
+
+    tgui_u32 sa = (texel >> 24) & 0xff;
+    if(sa == 0) return;
+
+    tgui_u32 sr = (((texel >> 16) & 0xff) * r + 127) / 255;
+    tgui_u32 sg = (((texel >>  8) & 0xff) * g + 127) / 255;
+    tgui_u32 sb = (((texel >>  0) & 0xff) * b + 127) / 255;
+
+    if(sa == 255) {
+        *pixel = 0xff000000 | (sr << 16) | (sg << 8) | (sb << 0);
+        return;
+    }
+
+    tgui_u32 des = *pixel;
+    tgui_u32 dr = (des >> 16) & 0xff;
+    tgui_u32 dg = (des >>  8) & 0xff;
+    tgui_u32 db = (des >>  0) & 0xff;
+
+    tgui_u32 cr = (sr * sa + dr * (255 - sa) + 127) / 255;
+    tgui_u32 cg = (sg * sa + dg * (255 - sa) + 127) / 255;
+    tgui_u32 cb = (sb * sa + db * (255 - sa) + 127) / 255;
+
+    *pixel = 0xff000000 | (cr << 16) | (cg << 8) | (cb << 0);
+}
+
+static inline tgui_f32 software_edge(TGuiSoftwareVertex *v0, TGuiSoftwareVertex *v1, tgui_f32 x, tgui_f32 y) {
+    return (v1->x - v0->x) * (y - v0->y) - (v1->y - v0->y) * (x - v0->x);
+}
+
+/* NOTE: Pixels whose center is exactly on an edge belong to only one of the triangles
+   sharing that edge, the edges are traversed in opposite directions */
+static inline tgui_b32 software_edge_is_owner(TGuiSoftwareVertex *v0, TGuiSoftwareVertex *v1) {
+    tgui_f32 dx = v1->x - v0->x;
+    tgui_f32 dy = v1->y - v0->y;
+    return (dy > 0.0f) || (dy == 0.0f && dx < 0.0f);
+}
+
+static void software_draw_triangle(TGuiSoftwareTexture *texture, tgui_b32 sdf, TGuiSoftwareVertex *a, TGuiSoftwareVertex *b, TGuiSoftwareVertex *c) {
+
+    tgui_f32 area = software_edge(a, b, c->x, c->y);
+    if(area == 0.0f) return;
+
+    if(area < 0.0f) {
+        TGuiSoftwareVertex *temp = b;
+        b = c;
+        c = temp;
+        area = -area;
+    }
+
+    TGuiRectangle clip = software.clip;
+
+    tgui_s32 min_x = TGUI_MAX((tgui_s32)TGUI_MIN3(a->x, b->x, c->x), clip.min_x);
+    tgui_s32 min_y = TGUI_MAX((tgui_s32)TGUI_MIN3(a->y, b->y, c->y), clip.min_y);
+    tgui_s32 max_x = TGUI_MIN((tgui_s32)TGUI_MAX3(a->x, b->x, c->x), clip.max_x);
+    tgui_s32 max_y = TGUI_MIN((tgui_s32)TGUI_MAX3(a->y, b->y, c->y), clip.max_y);
+
+    if(min_x > max_x || min_y > max_y) return;
+
+    tgui_b32 owner0 = software_edge_is_owner(b, c);
+    tgui_b32 owner1 = software_edge_is_owner(c, a);
+    tgui_b32 owner2 = software_edge_is_owner(a, b);
+
+    /* NOTE: Edge functions step, they are exact for the integer positions the painter emits */
+    tgui_f32 step_x0 = -(c->y - b->y), step_y0 = (c->x - b->x);
+    tgui_f32 step_x1 = -(a->y - c->y), step_y1 = (a->x - c->x);
+    tgui_f32 step_x2 = -(b->y - a->y), step_y2 = (b->x - a->x);
+
+    tgui_f32 start_x = (tgui_f32)min_x + 0.5f;
+    tgui_f32 start_y = (tgui_f32)min_y + 0.5f;
+
+    tgui_f32 row_w0 = software_edge(b, c, start_x, start_y);
+    tgui_f32 row_w1 = software_edge(c, a, start_x, start_y);
+    tgui_f32 row_w2 = software_edge(a, b, start_x, start_y);
+
+    tgui_f32 inv_area = 1.0f / area;
+
+    /* NOTE: Texels covered by one pixel, the uvs change linearly in the triangle */
+    tgui_f32 texels_per_pixel = 0.0f;
+    if(sdf && texture) {
+        tgui_f32 du_dx = (step_x0*a->u + step_x1*b->u + step_x2*c->u) * inv_area * (tgui_f32)texture->width;
+        tgui_f32 du_dy = (step_y0*a->u + step_y1*b->u + step_y2*c->u) * inv_area * (tgui_f32)texture->width;
+        tgui_f32 dv_dx = (step_x0*a->v + step_x1*b->v + step_x2*c->v) * inv_area * (tgui_f32)texture->height;
+        tgui_f32 dv_dy = (step_y0*a->v + step_y1*b->v + step_y2*c->v) * inv_area * (tgui_f32)texture->height;
+        texels_per_pixel = TGUI_MAX(fabsf(du_dx) + fabsf(du_dy), fabsf(dv_dx) + fabsf(dv_dy));
+    }
+
+    tgui_u32 *row = software.pixels + (min_y * software.width) + min_x;
+
+    for(tgui_s32 y = min_y; y <= max_y; ++y) {
+
+        tgui_f32 w0 = row_w0;
+        tgui_f32 w1 = row_w1;
+        tgui_f32 w2 = row_w2;
+
+        tgui_u32 *pixel = row;
+
+        for(tgui_s32 x = min_x; x <= max_x; ++x) {
+
+            tgui_b32 inside = (w0 > 0.0f || (w0 == 0.0f && owner0)) &&
+                              (w1 > 0.0f || (w1 == 0.0f && owner1)) &&
+                              (w2 > 0.0f || (w2 == 0.0f && owner2));
+
+            if(inside) {
+
+                tgui_f32 l0 = w0 * inv_area;
+                tgui_f32 l1 = w1 * inv_area;
+                tgui_f32 l2 = w2 * inv_area;
+
+                tgui_f32 u = l0*a->u + l1*b->u + l2*c->u;
+                tgui_f32 v = l0*a->v + l1*b->v + l2*c->v;
+
+                tgui_u32 r = (tgui_u32)(l0*a->r + l1*b->r + l2*c->r + 0.5f);
+                tgui_u32 g = (tgui_u32)(l0*a->g + l1*b->g + l2*c->g + 0.5f);
+                tgui_u32 b_ = (tgui_u32)(l0*a->b + l1*b->b + l2*c->b + 0.5f);
+
+                tgui_u32 texel = sdf ? software_texture_sample_sdf(texture, a->page, u, v, texels_per_pixel) : software_texture_sample(texture, a->page, u, v);
+                software_blend_pixel(pixel, texel, r, g, b_);
+            }
+
+            w0 += step_x0;
+            w1 += step_x1;
+            w2 += step_x2;
+            ++pixel;
+        }
+
+        row_w0 += step_y0;
+        row_w1 += step_y1;
+        row_w2 += step_y2;
+        row += software.width;
+    }
+}
+
+/* -------------------------------------------- */
+/*         TGui Backend implementation          */
+/* -------------------------------------------- */
+
+static void *tgui_gfx_software_create_program(char *vert, char *frag) {
+    TGUI_UNUSED(vert);
+    TGUI_UNUSED(frag);
+
+    TGuiSoftwareProgram *program = (TGuiSoftwareProgram *)malloc(sizeof(TGuiSoftwareProgram));
+    program->width = software.width;
+    program->height = software.height;
+
+    return program;
+}
+
+static void tgui_gfx_software_destroy_program(void *program) {
+    free(program);
+}
+
+static void *tgui_gfx_software_create_texture(tgui_u32 *data, tgui_u32 width, tgui_u32 height, tgui_u32 pages) {
+
+    tgui_u64 pixels_size = (tgui_u64)width*height*pages*sizeof(tgui_u32);
+
+    TGuiSoftwareTexture *texture = (TGuiSoftwareTexture *)malloc(sizeof(TGuiSoftwareTexture) + pixels_size);
+    texture->pixels = (tgui_u32 *)(texture + 1);
+    texture->width = width;
+    texture->height = height;
+    texture->pages = pages;
+
+    if(data) {
+        memcpy(texture->pixels, data, pixels_size);
+    } else {
+        memset(texture->pixels, 0, pixels_size);
+    }
+
+    return texture;
+}
+
+/* NOTE: The sampler works with 0xAARRGGBB texels, the coverage is expanded to white with alpha */
+static void *tgui_gfx_software_create_texture_r8(tgui_u8 *data, tgui_u32 width, tgui_u32 height) {
+
+    TGuiSoftwareTexture *texture = (TGuiSoftwareTexture *)tgui_gfx_software_create_texture(NULL, width, height, 1);
+
+    if(data) {
+        for(tgui_u32 i = 0; i < width*height; ++i) {
+            texture->pixels[i] = ((tgui_u32)data[i] << 24) | 0x00ffffff;
+        }
+    }
+
+    return texture;
+}
+
+static void tgui_gfx_software_update_texture(void *texture, tgui_u32 page, tgui_u32 *data, tgui_u32 stride, tgui_u32 x, tgui_u32 y, tgui_u32 w, tgui_u32 h) {
+    
+    TGuiSoftwareTexture *software_texture = (TGuiSoftwareTexture *)texture;
+    TGUI_ASSERT(x + w <= software_texture->width && y + h <= software_texture->height);
+
+    tgui_u32 *pixels = software_texture_page(software_texture, page);
+    for(tgui_u32 j = 0; j < h; ++j) {
+        memcpy(pixels + (tgui_u64)(y + j)*software_texture->width + x, data + (tgui_u64)j*stride, w*sizeof(tgui_u32));
+    }
+}
+
+static void tgui_gfx_software_update_texture_r8(void *texture, tgui_u8 *data, tgui_u32 stride, tgui_u32 x, tgui_u32 y, tgui_u32 w, tgui_u32 h) {
+    
+    TGuiSoftwareTexture *software_texture = (TGuiSoftwareTexture *)texture;
+    TGUI_ASSERT(x + w <= software_texture->width && y + h <= software_texture->height);
+
+    for(tgui_u32 j = 0; j < h; ++j) {
+        tgui_u32 *des = software_texture->pixels + (tgui_u64)(y + j)*software_texture->width + x;
+        tgui_u8 *src = data + (tgui_u64)j*stride;
+        for(tgui_u32 i = 0; i < w; ++i) {
+            des[i] = ((tgui_u32)src[i] << 24) | 0x00ffffff;
+        }
+    }
+}
+
+static void tgui_gfx_software_destroy_texture(void *texture) {
+    free(texture);
+}
+
+/* NOTE: Positions are used as framebuffer pixels, the program resolution must match the framebuffer */
+static void tgui_gfx_software_set_program_width_and_height(void *program, tgui_u32 width, tgui_u32 height) {
+    TGuiSoftwareProgram *software_program = (TGuiSoftwareProgram *)program;
+    software_program->width = width;
+    software_program->height = height;
+}
+
+static void tgui_gfx_software_set_clip(TGuiRectangle clip) {
+    TGuiRectangle framebuffer_rect = tgui_rect_from_wh(0, 0, software.width, software.height);
+    software.clip = tgui_rect_intersection(clip, framebuffer_rect);
+}
+
+static void tgui_gfx_software_draw_buffers(void *program, void *texture, tgui_b32 sdf, TGuiVertex *vertices, tgui_u32 vertices_count, void *indices, tgui_u32 indices_count, tgui_u32 index_size) {
+    TGUI_UNUSED(program);
+
+    if(tgui_rect_invalid(software.clip)) return;
+
+    TGuiSoftwareTexture *software_texture = (TGuiSoftwareTexture *)texture;
+
+    for(tgui_u32 i = 0; i + 2 < indices_count; i += 3) {
+
+        TGuiSoftwareVertex triangle[3];
+
+        for(tgui_u32 j = 0; j < 3; ++j) {
+            tgui_u32 index = (index_size == sizeof(tgui_u16)) ? ((tgui_u16 *)indices)[i + j] : ((tgui_u32 *)indices)[i + j];
+            TGUI_ASSERT(index < vertices_count);
+            software_fetch_vertex(triangle + j, vertices + index);
+        }
+
+        software_draw_triangle(software_texture, sdf, triangle + 0, triangle + 1, triangle + 2);
+    }
+}
+
+static void tgui_gfx_software_draw_instances(void *program, void *texture, tgui_b32 sdf, TGuiQuadInstance *instances, tgui_u32 instances_count) {
+    TGUI_UNUSED(program);
+
+    if(tgui_rect_invalid(software.clip)) return;
+
+    TGuiSoftwareTexture *software_texture = (TGuiSoftwareTexture *)texture;
+
+    for(tgui_u32 i = 0; i < instances_count; ++i) {
+
+        TGuiQuadInstance *instance = instances + i;
+
+        tgui_s32 width  = instance->max_x - instance->min_x;
+        tgui_s32 height = instance->max_y - instance->min_y;
+        if(width <= 0 || height <= 0) continue;
+
+        TGuiRectangle rect = { instance->min_x, instance->min_y, instance->max_x - 1, instance->max_y - 1 };
+        rect = tgui_rect_intersection(rect, software.clip);
+        if(tgui_rect_invalid(rect)) continue;
+
+        tgui_f32 min_u = (tgui_f32)instance->min_u / 65535.0f;
+        tgui_f32 min_v = (tgui_f32)instance->min_v / 65535.0f;
+        tgui_f32 du = ((tgui_f32)instance->max_u / 65535.0f - min_u) / (tgui_f32)width;
+        tgui_f32 dv = ((tgui_f32)instance->max_v / 65535.0f - min_v) / (tgui_f32)height;
+
+        tgui_u32 r = (instance->color >> 16) & 0xff;
+        tgui_u32 g = (instance->color >>  8) & 0xff;
+        tgui_u32 b = (instance->color >>  0) & 0xff;
+        tgui_u32 page = instance->color >> 24;
+
+        tgui_f32 texels_per_pixel = 0.0f;
+        if(sdf && software_texture) {
+            texels_per_pixel = TGUI_MAX(fabsf(du) * (tgui_f32)software_texture->width, fabsf(dv) * (tgui_f32)software_texture->height);
+        }
+
+        tgui_u32 *row = software.pixels + (rect.min_y * software.width) + rect.min_x;
+
+        for(tgui_s32 y = rect.min_y; y <= rect.max_y; ++y) {
+
+            tgui_f32 v = min_v + ((tgui_f32)(y - instance->min_y) + 0.5f) * dv;
+            tgui_u32 *pixel = row;
+
+            for(tgui_s32 x = rect.min_x; x <= rect.max_x; ++x) {
+                tgui_f32 u = min_u + ((tgui_f32)(x - instance->min_x) + 0.5f) * du;
+                tgui_u32 texel = sdf ? software_texture_sample_sdf(software_texture, page, u, v, texels_per_pixel) : software_texture_sample(software_texture, page, u, v);
+                software_blend_pixel(pixel++, texel, r, g, b);
+            }
+
+            row += software.width;
+        }
+    }
+}
+
+/* ---------------------------------------- */
+/*         TGui Software Gfx Backend        */
+/* ---------------------------------------- */
+
+void tgui_gfx_software_initialize(TGuiGfxBackend *gfx, tgui_u32 width, tgui_u32 height) {
+
+    memset(&software, 0, sizeof(TGuiSoftwareBackend));
+    tgui_gfx_software_resize(width, height);
+
+    gfx->create_program               = tgui_gfx_software_create_program;
+    gfx->destroy_program              = tgui_gfx_software_destroy_program;
+    gfx->create_texture               = tgui_gfx_software_create_texture;
+    gfx->destroy_texture              = tgui_gfx_software_destroy_texture;
+    gfx->create_texture_r8            = tgui_gfx_software_create_texture_r8;
+    gfx->update_texture               = tgui_gfx_software_update_texture;
+    gfx->update_texture_r8            = tgui_gfx_software_update_texture_r8;
+    gfx->set_program_width_and_height = tgui_gfx_software_set_program_width_and_height;
+    gfx->set_clip                     = tgui_gfx_software_set_clip;
+    gfx->draw_buffers                 = tgui_gfx_software_draw_buffers;
+    gfx->draw_instances               = tgui_gfx_software_draw_instances;
+    gfx->max_quads_per_batch          = TGUI_SOFTWARE_MAX_QUADS_PER_BATCH;
+}
+
+void tgui_gfx_software_terminate(void) {
+    free(software.pixels);
+    memset(&software, 0, sizeof(TGuiSoftwareBackend));
+}
+
+void tgui_gfx_software_resize(tgui_u32 width, tgui_u32 height) {
+
+    TGUI_ASSERT(width > 0 && height > 0);
+
+    free(software.pixels);
+    software.pixels = (tgui_u32 *)malloc(width*height*sizeof(tgui_u32));
+    software.width = width;
+    software.height = height;
+    software.clip = tgui_rect_from_wh(0, 0, width, height);
+
+    memset(software.pixels, 0, width*height*sizeof(tgui_u32));
+}
+
+void tgui_gfx_software_clear(tgui_u32 color) {
+
+    tgui_u32 pixels_count = software.width*software.height;
+    for(tgui_u32 i = 0; i < pixels_count; ++i) {
+        software.pixels[i] = color;
+    }
+
+    software.clip = tgui_rect_from_wh(0, 0, software.width, software.height);
+}
+
+tgui_u32 *tgui_gfx_software_get_pixels(tgui_u32 *width, tgui_u32 *height) {
+    if(width)  *width  = software.width;
+    if(height) *height = software.height;
+    return software.pixels;
+}
@@ -0,0 +1,24 @@
+#ifndef _TGUI_GFX_SOFTWARE_H_
+#define _TGUI_GFX_SOFTWARE_H_
+
+#include "tgui_gfx.h"
+
+/* ---------------------------------------- */
+/*         TGui Software Gfx Backend        */
+/* ---------------------------------------- */
+
+/* NOTE: CPU implementation of TGuiGfxBackend, it rasterizes the render buffers into an
+   in memory 0xAARRGGBB framebuffer so tgui can run without a GPU or a window system.
+   The backend callbacks have no user data so there is only one software backend per process */
+
+void tgui_gfx_software_initialize(TGuiGfxBackend *gfx, tgui_u32 width, tgui_u32 height);
+
+void tgui_gfx_software_terminate(void);
+
+void tgui_gfx_software_resize(tgui_u32 width, tgui_u32 height);
+
+void tgui_gfx_software_clear(tgui_u32 color);
+
+tgui_u32 *tgui_gfx_software_get_pixels(tgui_u32 *width, tgui_u32 *height);
+
+#endif /* _TGUI_GFX_SOFTWARE_H_ */
@@ -144,6 +144,20 @@ void tgui_virtual_arena_free(TGuiArena *arena) {
     arena->used = 0;
 }
 
+void tgui_virtual_arena_shrink(TGuiArena *arena, tgui_u64 used) {
+    
+    TGUI_ASSERT(arena->buffer && arena->type == TGUI_ARENA_TYPE_VIRTUAL);
+    TGUI_ASSERT(used <= arena->used);
+    arena->used = used;
+    
+    tgui_u64 page_size = tgui_os_get_page_size(); 
+    tgui_u64 commit_size = (used + (page_size - 1)) & ~(page_size - 1);
+    if(commit_size < arena->size) {
+        tgui_os_virtual_decommit((void *)(arena->buffer + commit_size), arena->size - commit_size);
+        arena->size = commit_size;
+    }
+}
+
 /* -------------------
        VirtualMap
    ------------------- */
@@ -70,6 +70,9 @@ void *tgui_virtual_arena_alloc(TGuiArena *arena, tgui_u64 size, tgui_u32 align);
 
 void tgui_virtual_arena_free(TGuiArena *arena);
 
+/* NOTE: Free the memory allocated after used and decommit the pages that are not needed anymore */
+void tgui_virtual_arena_shrink(TGuiArena *arena, tgui_u64 used);
+
 /* ------------------------
       Circular Link list 
    ------------------------ */
@@ -189,6 +192,9 @@ void _tgui_array_clear(TGuiVoidArray *array);
 #define tgui_array_clear(array) \
     _tgui_array_clear(&((array)->void_array))
 
+#define tgui_array_pop(array) \
+    ((array)->type_array.buffer[--(array)->type_array.size])
+
 #define tgui_array_get(array, index) \
     ((array)->type_array.buffer[(index)])
 
@@ -5,6 +5,10 @@
 
 #include <stdlib.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
 
 static inline void tgui_os_error(void) {
     printf("OS Error: %s\n", strerror(errno));
@@ -13,6 +17,9 @@ static inline void tgui_os_error(void) {
 
 static tgui_u64 g_os_page_size = 0;
 
+static void os_worker_pool_initialize(void);
+static void os_worker_pool_terminate(void);
+
 void tgui_os_initialize(void) {
 
     long result = sysconf(_SC_PAGESIZE); 
@@ -20,10 +27,177 @@ void tgui_os_initialize(void) {
         tgui_os_error();
     }
     g_os_page_size = (tgui_u64)result; 
+
+    os_worker_pool_initialize();
 }
 
 void tgui_os_terminate(void) {
+    os_worker_pool_terminate();
+}
+
+/* -------------------------
+        Worker Pool 
+   ------------------------- */
+
+#define TGUI_OS_MAX_WORKERS 63
+
+/* NOTE: One submission of tgui_os_parallel_for, it lives in the stack of the caller that waits
+   for every worker to be done with it before returning */
+typedef struct TGuiOsParallelFor {
+    TGuiOsJob job;
+    void *data;
+    tgui_u32 count;
+    tgui_u32 next;
+} TGuiOsParallelFor;
+
+typedef struct TGuiOsWorkerPool {
+
+    pthread_t threads[TGUI_OS_MAX_WORKERS];
+    tgui_u32 threads_count;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t work_cond;
+    pthread_cond_t done_cond;
+
+    /* NOTE: Protected by the mutex, generation change every time new work is submitted. Every
+       worker runs each generation once and the generation is finished when all of them did */
+    tgui_u32 generation;
+    tgui_u32 finished_count;
+    tgui_b32 quit;
+
+    TGuiOsParallelFor *parallel_for;
 
+} TGuiOsWorkerPool;
+
+static TGuiOsWorkerPool g_os_worker_pool;
+
+static void os_worker_pool_run_jobs(TGuiOsParallelFor *parallel_for) {
+    tgui_u32 index = __atomic_fetch_add(&parallel_for->next, 1, __ATOMIC_RELAXED);
+    while(index < parallel_for->count) {
+        parallel_for->job(parallel_for->data, index);
+        index = __atomic_fetch_add(&parallel_for->next, 1, __ATOMIC_RELAXED);
+    }
+}
+
+static void *os_worker_thread(void *param) {
+    TGUI_UNUSED(param);
+
+    TGuiOsWorkerPool *pool = &g_os_worker_pool;
+    
+    /* NOTE: Starts before the first generation so a worker created late still runs the work
+       submitted before it started */
+    tgui_u32 generation = 0;
+
+    pthread_mutex_lock(&pool->mutex);
+
+    while(true) {
+        
+        while(!pool->quit && generation == pool->generation) {
+            pthread_cond_wait(&pool->work_cond, &pool->mutex);
+        }
+        if(pool->quit) break;
+
+        /* NOTE: The caller waits for this worker so the generation can not change until it finishes */
+        generation = pool->generation;
+        TGuiOsParallelFor *parallel_for = pool->parallel_for;
+
+        pthread_mutex_unlock(&pool->mutex);
+        
+        os_worker_pool_run_jobs(parallel_for);
+        
+        pthread_mutex_lock(&pool->mutex);
+        
+        ++pool->finished_count;
+        if(pool->finished_count == pool->threads_count) {
+            pthread_cond_signal(&pool->done_cond);
+        }
+    }
+
+    pthread_mutex_unlock(&pool->mutex);
+    return NULL;
+}
+
+static void os_worker_pool_initialize(void) {
+
+    TGuiOsWorkerPool *pool = &g_os_worker_pool;
+    memset(pool, 0, sizeof(TGuiOsWorkerPool));
+
+    long cpus_count = sysconf(_SC_NPROCESSORS_ONLN);
+    if(cpus_count <= 1) return;
+
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->work_cond, NULL);
+    pthread_cond_init(&pool->done_cond, NULL);
+
+    /* NOTE: The calling thread also works, so one thread less than cpus */
+    tgui_u32 threads_count = TGUI_MIN((tgui_u32)cpus_count - 1, TGUI_OS_MAX_WORKERS);
+    for(tgui_u32 i = 0; i < threads_count; ++i) {
+        if(pthread_create(&pool->threads[pool->threads_count], NULL, os_worker_thread, NULL) != 0) {
+            break;
+        }
+        ++pool->threads_count;
+    }
+}
+
+static void os_worker_pool_terminate(void) {
+    
+    TGuiOsWorkerPool *pool = &g_os_worker_pool;
+    if(pool->threads_count == 0) return;
+
+    pthread_mutex_lock(&pool->mutex);
+    pool->quit = true;
+    pthread_cond_broadcast(&pool->work_cond);
+    pthread_mutex_unlock(&pool->mutex);
+
+    for(tgui_u32 i = 0; i < pool->threads_count; ++i) {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    pthread_cond_destroy(&pool->done_cond);
+    pthread_cond_destroy(&pool->work_cond);
+    pthread_mutex_destroy(&pool->mutex);
+    
+    memset(pool, 0, sizeof(TGuiOsWorkerPool));
+}
+
+void tgui_os_parallel_for(TGuiOsJob job, void *data, tgui_u32 count) {
+    
+    TGuiOsWorkerPool *pool = &g_os_worker_pool;
+    
+    if(pool->threads_count == 0 || count <= 1) {
+        for(tgui_u32 i = 0; i < count; ++i) {
+            job(data, i);
+        }
+        return;
+    }
+
+    TGuiOsParallelFor parallel_for;
+    parallel_for.job = job;
+    parallel_for.data = data;
+    parallel_for.count = count;
+    parallel_for.next = 0;
+
+    pthread_mutex_lock(&pool->mutex);
+    pool->parallel_for = &parallel_for;
+    pool->finished_count = 0;
+    ++pool->generation;
+    pthread_cond_broadcast(&pool->work_cond);
+    pthread_mutex_unlock(&pool->mutex);
+
+    os_worker_pool_run_jobs(&parallel_for);
+
+    /* NOTE: Every worker has to be done with this generation, even the ones that wake up after
+       all the jobs are finished, before parallel_for goes out of scope */
+    pthread_mutex_lock(&pool->mutex);
+    while(pool->finished_count < pool->threads_count) {
+        pthread_cond_wait(&pool->done_cond, &pool->mutex);
+    }
+    pool->parallel_for = NULL;
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+tgui_u32 tgui_os_get_workers_count(void) {
+    return g_os_worker_pool.threads_count + 1;
 }
 
 /* -------------------------
@@ -48,6 +222,7 @@ TGuiOsFile *tgui_os_file_read_entire(const char *path) {
     
     result->data = result + 1;
     result->size = file_size;
+    result->mapped_size = 0;
 
     TGUI_ASSERT(((tgui_u64)result->data % 8) == 0);
     fread(result->data, file_size+1, 1, file);
@@ -58,10 +233,114 @@ TGuiOsFile *tgui_os_file_read_entire(const char *path) {
     return result;
 }
 
+TGuiOsFile *tgui_os_file_map(const char *path, TGuiOsFileAccess access) {
+
+    int file = open(path, O_RDONLY);
+    if(file == -1) {
+        printf("Cannot load file: %s\n", path);
+        return NULL;
+    }
+
+    struct stat file_stat;
+    if(fstat(file, &file_stat) == -1) {
+        printf("Cannot load file: %s\n", path);
+        close(file);
+        return NULL;
+    }
+    
+    tgui_u64 file_size = (tgui_u64)file_stat.st_size;
+    
+    /* NOTE: The file is mapped over a reservation one page bigger, the bytes after the end of the
+       file are zero in its last page and in the extra page, so the data is always zero terminated */
+    tgui_u64 page_size = tgui_os_get_page_size();
+    tgui_u64 mapped_size = ((file_size + page_size - 1) & ~(page_size - 1)) + page_size;
+
+    void *data = mmap(NULL, (size_t)mapped_size, PROT_READ, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if(data == MAP_FAILED) {
+        printf("Cannot map file: %s\n", path);
+        close(file);
+        return NULL;
+    }
+    
+    if(file_size > 0) {
+        
+        void *file_data = mmap(data, (size_t)file_size, PROT_READ, MAP_SHARED | MAP_FIXED, file, 0);
+        if(file_data == MAP_FAILED) {
+            printf("Cannot map file: %s\n", path);
+            munmap(data, (size_t)mapped_size);
+            close(file);
+            return NULL;
+        }
+        TGUI_ASSERT(file_data == data);
+
+        int advice = (access == TGUI_OS_FILE_ACCESS_SEQUENTIAL) ? MADV_SEQUENTIAL : MADV_RANDOM;
+        madvise(data, (size_t)file_size, advice);
+    }
+
+    /* NOTE: The mapping keeps the file alive */
+    close(file);
+    
+    TGuiOsFile *result = (TGuiOsFile *)malloc(sizeof(TGuiOsFile));
+    result->data = data;
+    result->size = file_size;
+    result->mapped_size = mapped_size;
+    
+    return result;
+}
+
 void tgui_os_file_free(TGuiOsFile *file) {
+    if(file->mapped_size > 0) {
+        munmap(file->data, (size_t)file->mapped_size);
+    }
     free(file);
 }
 
+tgui_b32 tgui_os_file_exists(const char *path) {
+    struct stat file_stat;
+    return stat(path, &file_stat) == 0 && S_ISREG(file_stat.st_mode);
+}
+
+FILE *tgui_os_file_create_temp(const char *path, char *temp_path, tgui_u32 temp_path_size) {
+    
+    int length = snprintf(temp_path, temp_path_size, "%s.XXXXXX", path);
+    if(length < 0 || (tgui_u32)length >= temp_path_size) return NULL;
+
+    int fd = mkstemp(temp_path);
+    if(fd == -1) return NULL;
+
+    FILE *file = fdopen(fd, "wb");
+    if(!file) {
+        close(fd);
+        unlink(temp_path);
+    }
+    return file;
+}
+
+static tgui_b32 os_create_directory(const char *path) {
+    return mkdir(path, 0700) == 0 || errno == EEXIST;
+}
+
+tgui_b32 tgui_os_get_cache_path(char *buffer, tgui_u32 buffer_size, const char *name) {
+
+    /* NOTE: Relative values of XDG_CACHE_HOME are invalid and ignored */
+    const char *cache_home = getenv("XDG_CACHE_HOME");
+    int length = 0;
+    if(cache_home && cache_home[0] == '/') {
+        length = snprintf(buffer, buffer_size, "%s", cache_home);
+    } else {
+        const char *home = getenv("HOME");
+        if(!home || home[0] != '/') return false;
+        length = snprintf(buffer, buffer_size, "%s/.cache", home);
+    }
+    if(length < 0 || (tgui_u32)length >= buffer_size || !os_create_directory(buffer)) return false;
+
+    length += snprintf(buffer + length, buffer_size - length, "/tgui");
+    if((tgui_u32)length >= buffer_size || !os_create_directory(buffer)) return false;
+
+    length += snprintf(buffer + length, buffer_size - length, "/%s", name);
+    return (tgui_u32)length < buffer_size;
+}
+
 /* -------------------------
         Font Rasterizer 
    ------------------------- */
@@ -71,19 +350,49 @@ typedef struct TGuiOsFont {
     stbtt_fontinfo info;
     tgui_u32 size;
     tgui_f32 size_ratio;
+    /* NOTE: Fonts created with tgui_os_font_create_size share the file of the original font */
+    tgui_b32 owns_file;
 } TGuiOsFont;
 
 struct TGuiOsFont *tgui_os_font_create(struct TGuiArena *arena, const char *path, tgui_u32 size) {
+    TGuiOsFile *file = tgui_os_file_map(path, TGUI_OS_FILE_ACCESS_RANDOM);
+    if(!file) return NULL;
     TGuiOsFont *font = tgui_arena_push_struct(arena, TGuiOsFont, 8);
     font->size = size;
-    font->file = tgui_os_file_read_entire(path);
+    font->file = file;
+    font->owns_file = true;
     stbtt_InitFont(&font->info, font->file->data, stbtt_GetFontOffsetForIndex(font->file->data,0));
     font->size_ratio = stbtt_ScaleForPixelHeight(&font->info, size);
     return font;
 }
 
+struct TGuiOsFont *tgui_os_font_create_size(struct TGuiArena *arena, struct TGuiOsFont *font, tgui_u32 size) {
+    TGuiOsFont *result = tgui_arena_push_struct(arena, TGuiOsFont, 8);
+    result->size = size;
+    result->file = font->file;
+    result->info = font->info;
+    result->owns_file = false;
+    result->size_ratio = stbtt_ScaleForPixelHeight(&result->info, size);
+    return result;
+}
+
 void tgui_os_font_destroy(struct TGuiOsFont *font) {
-    tgui_os_file_free(font->file);
+    if(font->owns_file) {
+        tgui_os_file_free(font->file);
+    }
+}
+
+TGuiOsFile *tgui_os_font_get_file(struct TGuiOsFont *font) {
+    return font->file;
+}
+
+void *tgui_os_font_get_head_table(struct TGuiOsFont *font, tgui_u32 *size) {
+    /* NOTE: The head table of the OpenType spec has a fixed size */
+    tgui_u32 head_size = 54;
+    tgui_u64 head = (tgui_u64)font->info.head;
+    if(head == 0 || head + head_size > font->file->size) return NULL;
+    *size = head_size;
+    return (tgui_u8 *)font->file->data + head;
 }
 
 void tgui_os_font_rasterize_glyph(struct TGuiOsFont *font, tgui_u32 codepoint, void **buffer, tgui_s32 *w, tgui_s32 *h, tgui_s32 *bpp) {
@@ -91,6 +400,27 @@ void tgui_os_font_rasterize_glyph(struct TGuiOsFont *font, tgui_u32 codepoint, v
    *bpp = 1;
 }
 
+void tgui_os_font_rasterize_glyph_sdf(struct TGuiOsFont *font, tgui_u32 codepoint, tgui_s32 padding, tgui_u8 on_edge, tgui_f32 distance_scale, void **buffer, tgui_s32 *w, tgui_s32 *h, tgui_s32 *x_offset, tgui_s32 *y_offset) {
+    *buffer = stbtt_GetCodepointSDF(&font->info, font->size_ratio, codepoint, padding, on_edge, distance_scale, w, h, x_offset, y_offset);
+    if(!*buffer) {
+        *w = 0;
+        *h = 0;
+    }
+}
+
+void tgui_os_font_free_glyph_buffer(struct TGuiOsFont *font, void *buffer) {
+    (void)font;
+    stbtt_FreeBitmap(buffer, 0);
+}
+
+tgui_b32 tgui_os_font_has_codepoint(struct TGuiOsFont *font, tgui_u32 codepoint) {
+    return stbtt_FindGlyphIndex(&font->info, codepoint) != 0;
+}
+
+tgui_b32 tgui_os_font_has_kerning(struct TGuiOsFont *font) {
+    return font->info.kern != 0 || font->info.gpos != 0;
+}
+
 tgui_s32 tgui_os_font_get_kerning_between(struct TGuiOsFont *font, tgui_u32 codepoint0, tgui_u32 codepoint1) {
     return stbtt_GetCodepointKernAdvance(&font->info, codepoint0, codepoint1) * font->size_ratio;
 }
@@ -30,12 +30,49 @@ void tgui_os_virtual_release(void *ptr, tgui_u64 size);
 typedef struct TGuiOsFile {
     void *data;
     tgui_u64 size;
+    /* NOTE: Size of the mapping for files opened with tgui_os_file_map, 0 for files in the heap */
+    tgui_u64 mapped_size;
 } TGuiOsFile;
 
+/* NOTE: How the file is going to be read, used as a hint for the read ahead of mapped files */
+typedef enum TGuiOsFileAccess {
+    TGUI_OS_FILE_ACCESS_SEQUENTIAL,
+    TGUI_OS_FILE_ACCESS_RANDOM,
+} TGuiOsFileAccess;
+
 TGuiOsFile *tgui_os_file_read_entire(const char *path);
 
+/* NOTE: Map the file read only, the pages are shared with the page cache and the other processes
+   that map it. Like tgui_os_file_read_entire the data is followed by a zero byte. The file must not
+   be truncated while it is mapped */
+TGuiOsFile *tgui_os_file_map(const char *path, TGuiOsFileAccess access);
+
+/* NOTE: Free files created with tgui_os_file_read_entire or tgui_os_file_map */
 void tgui_os_file_free(TGuiOsFile *file);
 
+tgui_b32 tgui_os_file_exists(const char *path);
+
+/* NOTE: Create and open for writing a file with a unique name next to path, the name is written in
+   temp_path. Processes that write the same path at the same time never share the temporary file */
+FILE *tgui_os_file_create_temp(const char *path, char *temp_path, tgui_u32 temp_path_size);
+
+/* NOTE: Path of the file name in the cache directory of the user, $XDG_CACHE_HOME/tgui or
+   $HOME/.cache/tgui. The directories are created if they do not exist. Returns false if there is
+   no cache directory or the path does not fit in the buffer */
+tgui_b32 tgui_os_get_cache_path(char *buffer, tgui_u32 buffer_size, const char *name);
+
+
+/* -------------------------
+        Worker Pool 
+   ------------------------- */
+
+typedef void (*TGuiOsJob)(void *data, tgui_u32 index);
+
+/* NOTE: Call job for every index in [0, count) spread over the worker threads, the calling
+   thread also runs jobs and the function returns when all of them are finished */
+void tgui_os_parallel_for(TGuiOsJob job, void *data, tgui_u32 count);
+
+tgui_u32 tgui_os_get_workers_count(void);
 
 /* -------------------------
         Font Rasterizer 
@@ -46,10 +83,31 @@ struct TGuiOsFont;
 
 struct TGuiOsFont *tgui_os_font_create(struct TGuiArena *arena, const char *path, tgui_u32 size);
 
+/* NOTE: Create a font of a different size that shares the file and the font info of font */
+struct TGuiOsFont *tgui_os_font_create_size(struct TGuiArena *arena, struct TGuiOsFont *font, tgui_u32 size);
+
 void tgui_os_font_destroy(struct TGuiOsFont *font);
 
+/* NOTE: The file the font was loaded from, shared by all the sizes of the font */
+TGuiOsFile *tgui_os_font_get_file(struct TGuiOsFont *font);
+
+/* NOTE: The head table of the font in the file, it has the checksum of the whole file and the date
+   the font was modified. NULL if the font has no head table */
+void *tgui_os_font_get_head_table(struct TGuiOsFont *font, tgui_u32 *size);
+
 void tgui_os_font_rasterize_glyph(struct TGuiOsFont *font, tgui_u32 codepoint, void **buffer, tgui_s32 *w, tgui_s32 *h, tgui_s32 *bpp);
 
+/* NOTE: Signed distance field of the glyph, on_edge is the value on the outline and it changes distance_scale
+   per pixel. The buffer has padding pixels around the glyph and is NULL for empty glyphs, x_offset and
+   y_offset are the position of the top left corner relative to the pen and the baseline */
+void tgui_os_font_rasterize_glyph_sdf(struct TGuiOsFont *font, tgui_u32 codepoint, tgui_s32 padding, tgui_u8 on_edge, tgui_f32 distance_scale, void **buffer, tgui_s32 *w, tgui_s32 *h, tgui_s32 *x_offset, tgui_s32 *y_offset);
+
+void tgui_os_font_free_glyph_buffer(struct TGuiOsFont *font, void *buffer);
+
+tgui_b32 tgui_os_font_has_codepoint(struct TGuiOsFont *font, tgui_u32 codepoint);
+
+tgui_b32 tgui_os_font_has_kerning(struct TGuiOsFont *font);
+
 tgui_s32 tgui_os_font_get_kerning_between(struct TGuiOsFont *font, tgui_u32 codepoint0, tgui_u32 codepoint1);
 
 void tgui_os_font_get_vmetrics(struct TGuiOsFont *font, tgui_s32 *ascent, tgui_s32 *descent, tgui_s32 *line_gap); 
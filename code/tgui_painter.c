@@ -1,6 +1,7 @@
 #include "tgui_painter.h"
 
 #include "tgui_gfx.h"
+#include "tgui_os.h"
 
 static inline void clip_rectangle(TGuiRectangle *rect, TGuiRectangle clip, tgui_s32 *offset_x, tgui_s32 *offset_y) {
     
@@ -24,29 +25,926 @@ static inline void clip_rectangle(TGuiRectangle *rect, TGuiRectangle clip, tgui_
     if(offset_y) *offset_y = oy;
 }
 
-static void setup_vertex(TGuiVertex *vertex, tgui_s32 x, tgui_s32 y, tgui_f32 u, tgui_f32 v, tgui_u32 color) {
+static inline tgui_u16 uv_to_unorm16(tgui_f32 uv) {
+    return (tgui_u16)(TGUI_CLAMP(uv, 0.0f, 1.0f) * 65535.0f + 0.5f);
+}
+
+/* NOTE: The quads are opaque, the alpha byte of the packed colors is the page of the texture */
+static inline tgui_u32 color_with_page(tgui_u32 color, tgui_u32 page) {
+    TGUI_ASSERT(page < TGUI_TEXTURE_ATLAS_MAX_PAGES);
+    return (color & 0x00ffffff) | (page << 24);
+}
+
+#ifdef TGUI_PACKED_VERTEX
+
+static inline void setup_vertex(TGuiVertex *vertex, tgui_s32 x, tgui_s32 y, tgui_u16 u, tgui_u16 v, tgui_u32 color) {
+    vertex->x = (tgui_s16)x;
+    vertex->y = (tgui_s16)y;
+    vertex->u = u;
+    vertex->v = v;
+    vertex->color = color;
+}
+
+static void setup_quad_vertices(TGuiVertex *vertices, TGuiRectangle rect, tgui_f32 min_u, tgui_f32 min_v, tgui_f32 max_u, tgui_f32 max_v, tgui_u32 color, tgui_u32 page) {
     
+    tgui_u16 min_u16 = uv_to_unorm16(min_u);
+    tgui_u16 min_v16 = uv_to_unorm16(min_v);
+    tgui_u16 max_u16 = uv_to_unorm16(max_u);
+    tgui_u16 max_v16 = uv_to_unorm16(max_v);
+
+    color = color_with_page(color, page);
+
+    setup_vertex(vertices + 0, rect.min_x, rect.min_y, min_u16, min_v16, color);
+    setup_vertex(vertices + 1, rect.min_x, rect.max_y, min_u16, max_v16, color);
+    setup_vertex(vertices + 2, rect.max_x, rect.max_y, max_u16, max_v16, color);
+    setup_vertex(vertices + 3, rect.max_x, rect.min_y, max_u16, min_v16, color);
+}
+
+#else
+
+static inline void setup_vertex(TGuiVertex *vertex, tgui_s32 x, tgui_s32 y, tgui_f32 u, tgui_f32 v, tgui_f32 r, tgui_f32 g, tgui_f32 b, tgui_f32 page) {
     vertex->x = (tgui_f32)x;
     vertex->y = (tgui_f32)y;
     vertex->u = u;
     vertex->v = v;
+    vertex->r = r;
+    vertex->g = g;
+    vertex->b = b;
+    vertex->page = page;
+}
+
+static void setup_quad_vertices(TGuiVertex *vertices, TGuiRectangle rect, tgui_f32 min_u, tgui_f32 min_v, tgui_f32 max_u, tgui_f32 max_v, tgui_u32 color, tgui_u32 page) {
     
     tgui_f32 inv_255 = 1.0f / 255.0f;
 
-    vertex->r = ((color >> 16) & 0xff) * inv_255;
-    vertex->g = ((color >>  8) & 0xff) * inv_255;
-    vertex->b = ((color >>  0) & 0xff) * inv_255;
+    tgui_f32 r = ((color >> 16) & 0xff) * inv_255;
+    tgui_f32 g = ((color >>  8) & 0xff) * inv_255;
+    tgui_f32 b = ((color >>  0) & 0xff) * inv_255;
+    tgui_f32 p = (tgui_f32)page;
+
+    setup_vertex(vertices + 0, rect.min_x, rect.min_y, min_u, min_v, r, g, b, p);
+    setup_vertex(vertices + 1, rect.min_x, rect.max_y, min_u, max_v, r, g, b, p);
+    setup_vertex(vertices + 2, rect.max_x, rect.max_y, max_u, max_v, r, g, b, p);
+    setup_vertex(vertices + 3, rect.max_x, rect.min_y, max_u, min_v, r, g, b, p);
+}
+
+#endif
+
+static void push_quad_vertices(TGuiRenderBuffer *render_buffer, TGuiRectangle rect, tgui_f32 min_u, tgui_f32 min_v, tgui_f32 max_u, tgui_f32 max_v, tgui_u32 color, tgui_u32 page) {
+    
+    TGuiVertexArray *vertex_buffer = &render_buffer->vertex_buffer;
+
+    /* NOTE: The array memory is contiguous so the 4 vertices can be setup at once */
+    TGuiVertex *vertices = tgui_array_push(vertex_buffer);
+    tgui_array_push(vertex_buffer);
+    tgui_array_push(vertex_buffer);
+    tgui_array_push(vertex_buffer);
+    
+    setup_quad_vertices(vertices, rect, min_u, min_v, max_u, max_v, color, page);
+}
+
+static void push_quad_instance(TGuiRenderBuffer *render_buffer, TGuiRectangle rect, tgui_f32 min_u, tgui_f32 min_v, tgui_f32 max_u, tgui_f32 max_v, tgui_u32 color, tgui_u32 page) {
+
+    TGuiQuadInstance *instance = tgui_array_push(&render_buffer->instance_buffer);
+
+    instance->min_x = (tgui_s16)rect.min_x;
+    instance->min_y = (tgui_s16)rect.min_y;
+    instance->max_x = (tgui_s16)rect.max_x;
+    instance->max_y = (tgui_s16)rect.max_y;
+
+    instance->min_u = uv_to_unorm16(min_u);
+    instance->min_v = uv_to_unorm16(min_v);
+    instance->max_u = uv_to_unorm16(max_u);
+    instance->max_v = uv_to_unorm16(max_v);
+
+    instance->color = color_with_page(color, page);
+}
+
+/* NOTE: rect is in pixels with max_x and max_y exclusive */
+static void push_quad(TGuiPainter *painter, TGuiRectangle rect, tgui_f32 min_u, tgui_f32 min_v, tgui_f32 max_u, tgui_f32 max_v, tgui_u32 page, tgui_u32 color, void *texture, tgui_b32 sdf) {
+    
+    TGUI_ASSERT(tgui_painter_is_hardware(painter));
+
+    if(painter->type == TGUI_PAINTER_TYPE_HARDWARE_INSTANCED) {
+        push_quad_instance(painter->render_buffer, rect, min_u, min_v, max_u, max_v, color, page);
+    } else {
+        push_quad_vertices(painter->render_buffer, rect, min_u, min_v, max_u, max_v, color, page);
+    }
+
+    tgui_render_buffer_add_quads(painter->render_buffer, painter->clip, texture, sdf, 1);
+}
+
+#define TGUI_HARDWARE_COORD_MIN (-32768)
+#define TGUI_HARDWARE_COORD_MAX ( 32766)
+
+/* NOTE: Hardware painters leave the clipping to the backend scissor test, quads fully outside
+   the clip are rejected and only quads that cross the clip and do not fit in the int16
+   positions of the packed formats are clipped on the CPU. Return false if nothing is visible */
+static tgui_b32 hardware_clip_rectangle(TGuiPainter *painter, TGuiRectangle *rect, tgui_s32 *offset_x, tgui_s32 *offset_y) {
+    
+    TGuiRectangle clip = painter->clip;
+
+    if(offset_x) *offset_x = 0;
+    if(offset_y) *offset_y = 0;
+
+    if(tgui_rect_invalid(*rect) || tgui_rect_invalid(clip)) return false;
+
+    if(rect->max_x < clip.min_x || rect->min_x > clip.max_x ||
+       rect->max_y < clip.min_y || rect->min_y > clip.max_y) {
+        return false;
+    }
+
+    if(tgui_rect_inside(*rect, clip)) return true;
+
+    if(rect->min_x < TGUI_HARDWARE_COORD_MIN || rect->max_x > TGUI_HARDWARE_COORD_MAX ||
+       rect->min_y < TGUI_HARDWARE_COORD_MIN || rect->max_y > TGUI_HARDWARE_COORD_MAX) {
+        clip_rectangle(rect, clip, offset_x, offset_y);
+    }
+
+    return true;
+}
+
+/* ---------------------------------- */
+/*       Software raster kernels      */
+/* ---------------------------------- */
+
+/* NOTE: The software painter spends most of its time filling, copying and blending spans
+   of pixels, the span kernels are selected at runtime from the cpu features. The blend is
+   done in integer math, a division by 255 is (x + 128 + ((x + 128) >> 8)) >> 8 and fits in
+   16 bits, so the scalar and simd kernels produce exactly the same pixels. Like before the
+   blended pixels are written with alpha 0 */
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define TGUI_PAINTER_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+typedef void (*TGuiFillSpanFunc)(tgui_u32 *dst, tgui_u32 count, tgui_u32 color);
+typedef void (*TGuiCopySpanFunc)(tgui_u32 *dst, tgui_u32 *src, tgui_u32 count);
+typedef void (*TGuiBlendSpanFunc)(tgui_u32 *dst, tgui_u32 *src, tgui_u32 count, tgui_u32 tint);
+typedef void (*TGuiCoverageSpanFunc)(tgui_u32 *dst, tgui_u8 *src, tgui_u32 count, tgui_u32 tint);
+
+typedef struct TGuiRasterKernels {
+    TGuiFillSpanFunc fill_span;
+    TGuiCopySpanFunc copy_span;
+    TGuiBlendSpanFunc blend_span;
+    TGuiCoverageSpanFunc coverage_span;
+    tgui_b32 selected;
+} TGuiRasterKernels;
+
+static TGuiRasterKernels g_raster_kernels;
+
+static inline tgui_u32 div_255(tgui_u32 x) {
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+static void fill_span_scalar(tgui_u32 *dst, tgui_u32 count, tgui_u32 color) {
+    for(tgui_u32 i = 0; i < count; ++i) {
+        dst[i] = color;
+    }
+}
+
+static void copy_span_scalar(tgui_u32 *dst, tgui_u32 *src, tgui_u32 count) {
+    for(tgui_u32 i = 0; i < count; ++i) {
+        dst[i] = src[i];
+    }
+}
+
+static inline tgui_u32 blend_pixel(tgui_u32 des, tgui_u32 src, tgui_u32 tr, tgui_u32 tg, tgui_u32 tb) {
+
+    tgui_u32 sa = (src >> 24) & 0xff;
+    tgui_u32 da = 255 - sa;
+    
+    tgui_u32 sr = div_255(((src >> 16) & 0xff) * tr);
+    tgui_u32 sg = div_255(((src >>  8) & 0xff) * tg);
+    tgui_u32 sb = div_255(((src >>  0) & 0xff) * tb);
+
+    tgui_u32 cr = div_255(((des >> 16) & 0xff) * da + sr * sa);
+    tgui_u32 cg = div_255(((des >>  8) & 0xff) * da + sg * sa);
+    tgui_u32 cb = div_255(((des >>  0) & 0xff) * da + sb * sa);
+
+    return (cr << 16) | (cg << 8) | (cb << 0);
+}
+
+static void blend_span_scalar(tgui_u32 *dst, tgui_u32 *src, tgui_u32 count, tgui_u32 tint) {
+    
+    tgui_u32 tr = (tint >> 16) & 0xff;
+    tgui_u32 tg = (tint >>  8) & 0xff;
+    tgui_u32 tb = (tint >>  0) & 0xff;
+
+    for(tgui_u32 i = 0; i < count; ++i) {
+        dst[i] = blend_pixel(dst[i], src[i], tr, tg, tb);
+    }
+}
+
+static void coverage_span_scalar(tgui_u32 *dst, tgui_u8 *src, tgui_u32 count, tgui_u32 tint) {
+    
+    tgui_u32 tr = (tint >> 16) & 0xff;
+    tgui_u32 tg = (tint >>  8) & 0xff;
+    tgui_u32 tb = (tint >>  0) & 0xff;
+
+    for(tgui_u32 i = 0; i < count; ++i) {
+        dst[i] = blend_pixel(dst[i], ((tgui_u32)src[i] << 24) | 0x00ffffff, tr, tg, tb);
+    }
+}
+
+#ifdef TGUI_PAINTER_X86_SIMD
+
+/* NOTE: The simd blend works on 16 bit channels, two pixels per 128 bit lane */
+
+#define TGUI_SSE2_DIV_255(x) \
+    _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16((x), c128), _mm_srli_epi16(_mm_add_epi16((x), c128), 8)), 8)
+
+#define TGUI_AVX2_DIV_255(x) \
+    _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16((x), c128), _mm256_srli_epi16(_mm256_add_epi16((x), c128), 8)), 8)
+
+__attribute__((target("sse2")))
+static void fill_span_sse2(tgui_u32 *dst, tgui_u32 count, tgui_u32 color) {
+    __m128i c = _mm_set1_epi32((tgui_s32)color);
+    tgui_u32 i = 0;
+    for(; i + 4 <= count; i += 4) {
+        _mm_storeu_si128((__m128i *)(dst + i), c);
+    }
+    fill_span_scalar(dst + i, count - i, color);
+}
+
+__attribute__((target("sse2")))
+static void copy_span_sse2(tgui_u32 *dst, tgui_u32 *src, tgui_u32 count) {
+    tgui_u32 i = 0;
+    for(; i + 4 <= count; i += 4) {
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_loadu_si128((__m128i *)(src + i)));
+    }
+    copy_span_scalar(dst + i, src + i, count - i);
+}
+
+__attribute__((target("sse2")))
+static inline __m128i blend_pixels_sse2(__m128i d, __m128i s, __m128i tint, __m128i c128, __m128i c255) {
+    
+    __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    __m128i da = _mm_sub_epi16(c255, a);
+    s = _mm_mullo_epi16(s, tint);
+    s = TGUI_SSE2_DIV_255(s);
+    
+    __m128i c = _mm_add_epi16(_mm_mullo_epi16(d, da), _mm_mullo_epi16(s, a));
+    return TGUI_SSE2_DIV_255(c);
+}
+
+__attribute__((target("sse2")))
+static inline __m128i blend_4_pixels_sse2(__m128i d, __m128i s, __m128i t) {
+    
+    __m128i zero = _mm_setzero_si128();
+    __m128i c128 = _mm_set1_epi16(128);
+    __m128i c255 = _mm_set1_epi16(255);
+    __m128i rgb_mask = _mm_set1_epi32(0x00ffffff);
+    
+    __m128i lo = blend_pixels_sse2(_mm_unpacklo_epi8(d, zero), _mm_unpacklo_epi8(s, zero), t, c128, c255);
+    __m128i hi = blend_pixels_sse2(_mm_unpackhi_epi8(d, zero), _mm_unpackhi_epi8(s, zero), t, c128, c255);
+    
+    return _mm_and_si128(_mm_packus_epi16(lo, hi), rgb_mask);
+}
+
+__attribute__((target("sse2")))
+static void blend_span_sse2(tgui_u32 *dst, tgui_u32 *src, tgui_u32 count, tgui_u32 tint) {
+
+    __m128i zero = _mm_setzero_si128();
+    __m128i rgb_mask = _mm_set1_epi32(0x00ffffff);
+    __m128i alpha_mask = _mm_set1_epi32((tgui_s32)0xff000000);
+    __m128i t = _mm_unpacklo_epi8(_mm_set1_epi32((tgui_s32)(tint & 0x00ffffff)), zero);
+
+    tgui_u32 i = 0;
+    for(; i + 4 <= count; i += 4) {
+        
+        __m128i s = _mm_loadu_si128((__m128i *)(src + i));
+        __m128i d = _mm_loadu_si128((__m128i *)(dst + i));
+        
+        /* NOTE: Glyphs are mostly transparent pixels, skip the math for them */
+        if(_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(s, alpha_mask), zero)) == 0xffff) {
+            _mm_storeu_si128((__m128i *)(dst + i), _mm_and_si128(d, rgb_mask));
+            continue;
+        }
+
+        _mm_storeu_si128((__m128i *)(dst + i), blend_4_pixels_sse2(d, s, t));
+    }
+    blend_span_scalar(dst + i, src + i, count - i, tint);
+}
+
+__attribute__((target("sse2")))
+static void coverage_span_sse2(tgui_u32 *dst, tgui_u8 *src, tgui_u32 count, tgui_u32 tint) {
+
+    __m128i zero = _mm_setzero_si128();
+    __m128i rgb_mask = _mm_set1_epi32(0x00ffffff);
+    __m128i t = _mm_unpacklo_epi8(_mm_set1_epi32((tgui_s32)(tint & 0x00ffffff)), zero);
+
+    tgui_u32 i = 0;
+    for(; i + 4 <= count; i += 4) {
+        
+        tgui_u32 coverage;
+        memcpy(&coverage, src + i, sizeof(coverage));
+        
+        __m128i d = _mm_loadu_si128((__m128i *)(dst + i));
+        if(coverage == 0) {
+            _mm_storeu_si128((__m128i *)(dst + i), _mm_and_si128(d, rgb_mask));
+            continue;
+        }
+        
+        /* NOTE: Expand the coverage to white pixels with coverage alpha */
+        __m128i a = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128((tgui_s32)coverage), zero), zero);
+        __m128i s = _mm_or_si128(_mm_slli_epi32(a, 24), rgb_mask);
+
+        _mm_storeu_si128((__m128i *)(dst + i), blend_4_pixels_sse2(d, s, t));
+    }
+    coverage_span_scalar(dst + i, src + i, count - i, tint);
+}
+
+__attribute__((target("avx2")))
+static void fill_span_avx2(tgui_u32 *dst, tgui_u32 count, tgui_u32 color) {
+    __m256i c = _mm256_set1_epi32((tgui_s32)color);
+    tgui_u32 i = 0;
+    for(; i + 8 <= count; i += 8) {
+        _mm256_storeu_si256((__m256i *)(dst + i), c);
+    }
+    fill_span_sse2(dst + i, count - i, color);
+}
+
+__attribute__((target("avx2")))
+static void copy_span_avx2(tgui_u32 *dst, tgui_u32 *src, tgui_u32 count) {
+    tgui_u32 i = 0;
+    for(; i + 8 <= count; i += 8) {
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_loadu_si256((__m256i *)(src + i)));
+    }
+    copy_span_sse2(dst + i, src + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i blend_pixels_avx2(__m256i d, __m256i s, __m256i tint, __m256i c128, __m256i c255) {
+    
+    __m256i a = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    __m256i da = _mm256_sub_epi16(c255, a);
+    s = _mm256_mullo_epi16(s, tint);
+    s = TGUI_AVX2_DIV_255(s);
+    
+    __m256i c = _mm256_add_epi16(_mm256_mullo_epi16(d, da), _mm256_mullo_epi16(s, a));
+    return TGUI_AVX2_DIV_255(c);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i blend_8_pixels_avx2(__m256i d, __m256i s, __m256i t) {
+    
+    __m256i zero = _mm256_setzero_si256();
+    __m256i c128 = _mm256_set1_epi16(128);
+    __m256i c255 = _mm256_set1_epi16(255);
+    __m256i rgb_mask = _mm256_set1_epi32(0x00ffffff);
+    
+    /* NOTE: unpack and pack work inside each 128 bit lane so the pixel order is kept */
+    __m256i lo = blend_pixels_avx2(_mm256_unpacklo_epi8(d, zero), _mm256_unpacklo_epi8(s, zero), t, c128, c255);
+    __m256i hi = blend_pixels_avx2(_mm256_unpackhi_epi8(d, zero), _mm256_unpackhi_epi8(s, zero), t, c128, c255);
+    
+    return _mm256_and_si256(_mm256_packus_epi16(lo, hi), rgb_mask);
+}
+
+__attribute__((target("avx2")))
+static void blend_span_avx2(tgui_u32 *dst, tgui_u32 *src, tgui_u32 count, tgui_u32 tint) {
+
+    __m256i zero = _mm256_setzero_si256();
+    __m256i rgb_mask = _mm256_set1_epi32(0x00ffffff);
+    __m256i alpha_mask = _mm256_set1_epi32((tgui_s32)0xff000000);
+    __m256i t = _mm256_unpacklo_epi8(_mm256_set1_epi32((tgui_s32)(tint & 0x00ffffff)), zero);
+
+    tgui_u32 i = 0;
+    for(; i + 8 <= count; i += 8) {
+        
+        __m256i s = _mm256_loadu_si256((__m256i *)(src + i));
+        __m256i d = _mm256_loadu_si256((__m256i *)(dst + i));
+        
+        if(_mm256_testz_si256(s, alpha_mask)) {
+            _mm256_storeu_si256((__m256i *)(dst + i), _mm256_and_si256(d, rgb_mask));
+            continue;
+        }
+
+        _mm256_storeu_si256((__m256i *)(dst + i), blend_8_pixels_avx2(d, s, t));
+    }
+    blend_span_sse2(dst + i, src + i, count - i, tint);
+}
+
+__attribute__((target("avx2")))
+static void coverage_span_avx2(tgui_u32 *dst, tgui_u8 *src, tgui_u32 count, tgui_u32 tint) {
+
+    __m256i zero = _mm256_setzero_si256();
+    __m256i rgb_mask = _mm256_set1_epi32(0x00ffffff);
+    __m256i t = _mm256_unpacklo_epi8(_mm256_set1_epi32((tgui_s32)(tint & 0x00ffffff)), zero);
+
+    tgui_u32 i = 0;
+    for(; i + 8 <= count; i += 8) {
+        
+        tgui_u64 coverage;
+        memcpy(&coverage, src + i, sizeof(coverage));
+        
+        __m256i d = _mm256_loadu_si256((__m256i *)(dst + i));
+        if(coverage == 0) {
+            _mm256_storeu_si256((__m256i *)(dst + i), _mm256_and_si256(d, rgb_mask));
+            continue;
+        }
+
+        __m256i a = _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i *)(src + i)));
+        __m256i s = _mm256_or_si256(_mm256_slli_epi32(a, 24), rgb_mask);
+
+        _mm256_storeu_si256((__m256i *)(dst + i), blend_8_pixels_avx2(d, s, t));
+    }
+    coverage_span_sse2(dst + i, src + i, count - i, tint);
+}
+
+#endif /* TGUI_PAINTER_X86_SIMD */
+
+static void raster_kernels_select(void) {
+    
+    if(g_raster_kernels.selected) return;
+
+    g_raster_kernels.fill_span  = fill_span_scalar;
+    g_raster_kernels.copy_span  = copy_span_scalar;
+    g_raster_kernels.blend_span = blend_span_scalar;
+    g_raster_kernels.coverage_span = coverage_span_scalar;
+
+#ifdef TGUI_PAINTER_X86_SIMD
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")) {
+        g_raster_kernels.fill_span  = fill_span_avx2;
+        g_raster_kernels.copy_span  = copy_span_avx2;
+        g_raster_kernels.blend_span = blend_span_avx2;
+        g_raster_kernels.coverage_span = coverage_span_avx2;
+    } else if(__builtin_cpu_supports("sse2")) {
+        g_raster_kernels.fill_span  = fill_span_sse2;
+        g_raster_kernels.copy_span  = copy_span_sse2;
+        g_raster_kernels.blend_span = blend_span_sse2;
+        g_raster_kernels.coverage_span = coverage_span_sse2;
+    }
+#endif
+
+    g_raster_kernels.selected = true;
+}
+
+/* NOTE: rect is already clipped and inclusive, (src_x, src_y) is the bitmap pixel drawn at (rect.min_x, rect.min_y) */
+
+static void raster_fill(tgui_u32 *pixels, tgui_u32 stride, TGuiRectangle rect, tgui_u32 color) {
+
+    tgui_u32 *row = pixels + (rect.min_y * stride) + rect.min_x;
+    tgui_u32 count = tgui_rect_width(rect);
+
+    for(tgui_s32 y = rect.min_y; y <= rect.max_y; ++y) {
+        g_raster_kernels.fill_span(row, count, color);
+        row += stride;
+    }
+}
+
+static void raster_copy_bitmap(tgui_u32 *pixels, tgui_u32 stride, TGuiRectangle rect, TGuiBitmap *bitmap, tgui_s32 src_x, tgui_s32 src_y) {
+
+    tgui_u32 *row = pixels + (rect.min_y * stride) + rect.min_x;
+    tgui_u32 *src_row = bitmap->pixels + (src_y * bitmap->width) + src_x;
+    tgui_u32 count = tgui_rect_width(rect);
+
+    for(tgui_s32 y = rect.min_y; y <= rect.max_y; ++y) {
+        g_raster_kernels.copy_span(row, src_row, count);
+        row += stride;
+        src_row += bitmap->width;
+    }
+}
+
+static void raster_blend_bitmap(tgui_u32 *pixels, tgui_u32 stride, TGuiRectangle rect, TGuiBitmap *bitmap, tgui_s32 src_x, tgui_s32 src_y, tgui_u32 tint) {
+
+    tgui_u32 *row = pixels + (rect.min_y * stride) + rect.min_x;
+    tgui_u32 *src_row = bitmap->pixels + (src_y * bitmap->width) + src_x;
+    tgui_u32 count = tgui_rect_width(rect);
+
+    for(tgui_s32 y = rect.min_y; y <= rect.max_y; ++y) {
+        g_raster_kernels.blend_span(row, src_row, count, tint);
+        row += stride;
+        src_row += bitmap->width;
+    }
+}
+
+static void raster_blend_coverage(tgui_u32 *pixels, tgui_u32 stride, TGuiRectangle rect, TGuiGlyphAtlas *glyph_atlas, tgui_s32 src_x, tgui_s32 src_y, tgui_u32 tint) {
+
+    tgui_u32 *row = pixels + (rect.min_y * stride) + rect.min_x;
+    tgui_u8 *src_row = glyph_atlas->pixels + (src_y * glyph_atlas->width) + src_x;
+    tgui_u32 count = tgui_rect_width(rect);
+
+    for(tgui_s32 y = rect.min_y; y <= rect.max_y; ++y) {
+        g_raster_kernels.coverage_span(row, src_row, count, tint);
+        row += stride;
+        src_row += glyph_atlas->width;
+    }
+}
+
+static void raster_blend_sdf(tgui_u32 *pixels, tgui_u32 stride, TGuiRectangle rect, TGuiGlyphAtlas *glyph_atlas, TGuiRectangle src_rect, TGuiRectangle dst_rect, tgui_u32 tint) {
+
+    tgui_f32 scale_x = (tgui_f32)tgui_rect_width(src_rect) / (tgui_f32)tgui_rect_width(dst_rect);
+    tgui_f32 scale_y = (tgui_f32)tgui_rect_height(src_rect) / (tgui_f32)tgui_rect_height(dst_rect);
+    tgui_f32 texels_per_pixel = TGUI_MAX(scale_x, scale_y);
+
+    /* NOTE: The coverage is computed in spans of TGUI_TILE_SIZE and blended with the coverage kernel */
+    tgui_u8 coverage[TGUI_TILE_SIZE];
+
+    tgui_u32 *row = pixels + (rect.min_y * stride);
+
+    for(tgui_s32 y = rect.min_y; y <= rect.max_y; ++y) {
+        
+        tgui_f32 src_y = (tgui_f32)src_rect.min_y + ((tgui_f32)(y - dst_rect.min_y) + 0.5f) * scale_y - 0.5f;
+        
+        for(tgui_s32 x = rect.min_x; x <= rect.max_x; x += TGUI_TILE_SIZE) {
+            
+            tgui_u32 count = TGUI_MIN(rect.max_x - x + 1, TGUI_TILE_SIZE);
+            
+            for(tgui_u32 i = 0; i < count; ++i) {
+                tgui_f32 src_x = (tgui_f32)src_rect.min_x + ((tgui_f32)(x + (tgui_s32)i - dst_rect.min_x) + 0.5f) * scale_x - 0.5f;
+                coverage[i] = tgui_sdf_coverage(tgui_glyph_atlas_sample_sdf(glyph_atlas, src_rect, src_x, src_y), texels_per_pixel);
+            }
+
+            g_raster_kernels.coverage_span(row + x, coverage, count, tint);
+        }
+
+        row += stride;
+    }
+}
+
+static void raster_command(tgui_u32 *pixels, tgui_u32 stride, TGuiSoftwareCommand *command, TGuiRectangle rect) {
+
+    tgui_s32 src_x = command->src_x + (rect.min_x - command->rect.min_x);
+    tgui_s32 src_y = command->src_y + (rect.min_y - command->rect.min_y);
+
+    switch(command->type) {
+    case TGUI_SOFTWARE_COMMAND_FILL: {
+        raster_fill(pixels, stride, rect, command->color);
+    } break;
+    case TGUI_SOFTWARE_COMMAND_COPY_BITMAP: {
+        raster_copy_bitmap(pixels, stride, rect, command->bitmap, src_x, src_y);
+    } break;
+    case TGUI_SOFTWARE_COMMAND_BLEND_BITMAP: {
+        raster_blend_bitmap(pixels, stride, rect, command->bitmap, src_x, src_y, command->color);
+    } break;
+    case TGUI_SOFTWARE_COMMAND_BLEND_COVERAGE: {
+        raster_blend_coverage(pixels, stride, rect, command->glyph_atlas, src_x, src_y, command->color);
+    } break;
+    case TGUI_SOFTWARE_COMMAND_BLEND_SDF: {
+        raster_blend_sdf(pixels, stride, rect, command->glyph_atlas, command->src_rect, command->dst_rect, command->color);
+    } break;
+    }
+}
+
+/* ---------------------------- */
+/*       TGui Tile Binner       */
+/* ---------------------------- */
+
+void tgui_tile_binner_initialize(TGuiTileBinner *binner) {
+    tgui_array_initialize(&binner->commands);
+    tgui_array_initialize(&binner->tile_first_command);
+    tgui_array_initialize(&binner->tile_commands);
+    binner->pixels = NULL;
+    binner->stride = 0;
+    binner->width = 0;
+    binner->height = 0;
+    binner->tiles_x = 0;
+    binner->tiles_y = 0;
+    tgui_array_initialize(&binner->tile_hashes);
+    tgui_array_initialize(&binner->damaged_tiles);
+    binner->hashed_width = 0;
+    binner->hashed_height = 0;
+    binner->invalid = true;
+}
+
+void tgui_tile_binner_terminate(TGuiTileBinner *binner) {
+    tgui_array_terminate(&binner->damaged_tiles);
+    tgui_array_terminate(&binner->tile_hashes);
+    tgui_array_terminate(&binner->commands);
+    tgui_array_terminate(&binner->tile_first_command);
+    tgui_array_terminate(&binner->tile_commands);
+}
+
+void tgui_tile_binner_invalidate(TGuiTileBinner *binner) {
+    binner->invalid = true;
+}
+
+static TGuiSoftwareCommand *tile_binner_push(TGuiPainter *painter, TGuiSoftwareCommandType type, TGuiRectangle rect, tgui_u32 color, TGuiBitmap *bitmap, TGuiGlyphAtlas *glyph_atlas, tgui_s32 src_x, tgui_s32 src_y) {
+    
+    TGuiSoftwareCommand *command = tgui_array_push(&painter->binner->commands);
+    command->type = type;
+    command->rect = rect;
+    command->color = color;
+    command->bitmap = bitmap;
+    command->glyph_atlas = glyph_atlas;
+    command->src_x = src_x;
+    command->src_y = src_y;
+    command->src_rect = tgui_rect_set_invalid();
+    command->dst_rect = tgui_rect_set_invalid();
+    return command;
+}
+
+static inline TGuiRectangle tile_binner_tile_rect(TGuiTileBinner *binner, tgui_u32 tile_x, tgui_u32 tile_y) {
+    TGuiRectangle result;
+    result.min_x = tile_x * TGUI_TILE_SIZE;
+    result.min_y = tile_y * TGUI_TILE_SIZE;
+    result.max_x = TGUI_MIN(result.min_x + TGUI_TILE_SIZE, (tgui_s32)binner->width)  - 1;
+    result.max_y = TGUI_MIN(result.min_y + TGUI_TILE_SIZE, (tgui_s32)binner->height) - 1;
+    return result;
+}
+
+/* NOTE: Every tile is rasterized by only one thread with the commands in submission order */
+static void tile_binner_raster_tile(void *data, tgui_u32 tile_index) {
+
+    TGuiTileBinner *binner = (TGuiTileBinner *)data;
+    
+    TGUI_ASSERT(tile_index < binner->tiles_x * binner->tiles_y);
+
+    TGuiRectangle tile_rect = tile_binner_tile_rect(binner, tile_index % binner->tiles_x, tile_index / binner->tiles_x);
+
+    tgui_u32 first = tgui_array_get(&binner->tile_first_command, tile_index);
+    tgui_u32 last  = tgui_array_get(&binner->tile_first_command, tile_index + 1);
+
+    for(tgui_u32 i = first; i < last; ++i) {
+        TGuiSoftwareCommand *command = tgui_array_get_ptr(&binner->commands, tgui_array_get(&binner->tile_commands, i));
+        TGuiRectangle rect = tgui_rect_intersection(command->rect, tile_rect);
+        raster_command(binner->pixels, binner->stride, command, rect);
+    }
+}
+
+static void tile_binner_raster_damaged_tile(void *data, tgui_u32 index) {
+    TGuiTileBinner *binner = (TGuiTileBinner *)data;
+    tile_binner_raster_tile(binner, tgui_array_get(&binner->damaged_tiles, index));
+}
+
+static inline tgui_u64 hash_combine(tgui_u64 hash, tgui_u64 value) {
+    return hash ^ (value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2));
+}
+
+static inline tgui_u64 hash_rect(tgui_u64 hash, TGuiRectangle rect) {
+    hash = hash_combine(hash, ((tgui_u64)(tgui_u32)rect.min_x << 32) | (tgui_u32)rect.min_y);
+    return hash_combine(hash, ((tgui_u64)(tgui_u32)rect.max_x << 32) | (tgui_u32)rect.max_y);
+}
+
+static tgui_u64 tile_binner_hash_tile(TGuiTileBinner *binner, tgui_u32 tile_index) {
+    
+    tgui_u32 first = tgui_array_get(&binner->tile_first_command, tile_index);
+    tgui_u32 last  = tgui_array_get(&binner->tile_first_command, tile_index + 1);
+    
+    tgui_u64 hash = hash_combine(0, last - first);
+    for(tgui_u32 i = first; i < last; ++i) {
+        TGuiSoftwareCommand *command = tgui_array_get_ptr(&binner->commands, tgui_array_get(&binner->tile_commands, i));
+        hash = hash_combine(hash, ((tgui_u64)command->type << 32) | command->color);
+        hash = hash_rect(hash, command->rect);
+        hash = hash_combine(hash, (tgui_u64)command->bitmap);
+        hash = hash_combine(hash, (tgui_u64)command->glyph_atlas);
+        hash = hash_combine(hash, ((tgui_u64)(tgui_u32)command->src_x << 32) | (tgui_u32)command->src_y);
+        hash = hash_rect(hash, command->src_rect);
+        hash = hash_rect(hash, command->dst_rect);
+    }
+    return hash;
+}
+
+/* NOTE: Keep the tiles whose commands changed since the last flush and add them to damage */
+static void tile_binner_find_damaged_tiles(TGuiTileBinner *binner, TGuiDamage *damage) {
+    
+    tgui_u32 tiles_count = binner->tiles_x * binner->tiles_y;
+    
+    if(binner->hashed_width != binner->width || binner->hashed_height != binner->height) {
+        binner->invalid = true;
+        binner->hashed_width = binner->width;
+        binner->hashed_height = binner->height;
+    }
+    
+    if(tgui_array_size(&binner->tile_hashes) < tiles_count) {
+        tgui_array_reserve(&binner->tile_hashes, tiles_count - tgui_array_size(&binner->tile_hashes));
+    }
+    tgui_u64 *tile_hashes = tgui_array_data(&binner->tile_hashes);
+
+    tgui_array_clear(&binner->damaged_tiles);
+    for(tgui_u32 i = 0; i < tiles_count; ++i) {
+        tgui_u64 hash = tile_binner_hash_tile(binner, i);
+        if(!binner->invalid && tile_hashes[i] == hash) continue;
+        
+        tile_hashes[i] = hash;
+        *tgui_array_push(&binner->damaged_tiles) = i;
+        tgui_damage_add(damage, tile_binner_tile_rect(binner, i % binner->tiles_x, i / binner->tiles_x));
+    }
+
+    binner->invalid = false;
+}
+
+static inline void tile_binner_command_tiles(TGuiSoftwareCommand *command, tgui_u32 *min_x, tgui_u32 *min_y, tgui_u32 *max_x, tgui_u32 *max_y) {
+    *min_x = command->rect.min_x / TGUI_TILE_SIZE;
+    *min_y = command->rect.min_y / TGUI_TILE_SIZE;
+    *max_x = command->rect.max_x / TGUI_TILE_SIZE;
+    *max_y = command->rect.max_y / TGUI_TILE_SIZE;
+}
+
+static void tile_binner_flush(TGuiTileBinner *binner, TGuiDamage *damage) {
+
+    tgui_u32 commands_count = tgui_array_size(&binner->commands);
+    if(commands_count == 0 && !damage) return;
+
+    tgui_u32 tiles_count = binner->tiles_x * binner->tiles_y;
+    
+    /* NOTE: The arrays are only grown, the first elements are used as scratch memory */
+    if(tgui_array_size(&binner->tile_first_command) < tiles_count + 1) {
+        tgui_array_reserve(&binner->tile_first_command, (tiles_count + 1) - tgui_array_size(&binner->tile_first_command));
+    }
+    tgui_u32 *tile_first_command = tgui_array_data(&binner->tile_first_command);
+    memset(tile_first_command, 0, (tiles_count + 1) * sizeof(tgui_u32));
+
+    /* NOTE: Counting sort of the commands per tile, the order of the commands in a tile is kept */
+    tgui_u32 tile_commands_count = 0;
+    for(tgui_u32 i = 0; i < commands_count; ++i) {
+        TGuiSoftwareCommand *command = tgui_array_get_ptr(&binner->commands, i);
+        tgui_u32 min_x, min_y, max_x, max_y;
+        tile_binner_command_tiles(command, &min_x, &min_y, &max_x, &max_y);
+        for(tgui_u32 y = min_y; y <= max_y; ++y) {
+            for(tgui_u32 x = min_x; x <= max_x; ++x) {
+                ++tile_first_command[y * binner->tiles_x + x + 1];
+                ++tile_commands_count;
+            }
+        }
+    }
+
+    for(tgui_u32 i = 0; i < tiles_count; ++i) {
+        tile_first_command[i + 1] += tile_first_command[i];
+    }
+
+    if(tgui_array_size(&binner->tile_commands) < tile_commands_count) {
+        tgui_array_reserve(&binner->tile_commands, tile_commands_count - tgui_array_size(&binner->tile_commands));
+    }
+    tgui_u32 *tile_commands = tgui_array_data(&binner->tile_commands);
+
+    for(tgui_u32 i = 0; i < commands_count; ++i) {
+        TGuiSoftwareCommand *command = tgui_array_get_ptr(&binner->commands, i);
+        tgui_u32 min_x, min_y, max_x, max_y;
+        tile_binner_command_tiles(command, &min_x, &min_y, &max_x, &max_y);
+        for(tgui_u32 y = min_y; y <= max_y; ++y) {
+            for(tgui_u32 x = min_x; x <= max_x; ++x) {
+                tile_commands[tile_first_command[y * binner->tiles_x + x]++] = i;
+            }
+        }
+    }
+
+    /* NOTE: After the fill every tile start points to the next tile start, shift it back */
+    for(tgui_u32 i = tiles_count; i > 0; --i) {
+        tile_first_command[i] = tile_first_command[i - 1];
+    }
+    tile_first_command[0] = 0;
+
+    if(damage) {
+        tile_binner_find_damaged_tiles(binner, damage);
+        tgui_os_parallel_for(tile_binner_raster_damaged_tile, binner, tgui_array_size(&binner->damaged_tiles));
+    } else {
+        tgui_os_parallel_for(tile_binner_raster_tile, binner, tiles_count);
+    }
+
+    tgui_array_clear(&binner->commands);
+}
+
+/* NOTE: The binned painter adds the damage of the tiles that changed when it is flushed */
+static inline void software_add_damage(TGuiPainter *painter, TGuiRectangle rect) {
+    if(painter->damage && painter->type != TGUI_PAINTER_TYPE_SOFTWARE_BINNED) {
+        tgui_damage_add(painter->damage, rect);
+    }
+}
+
+/* NOTE: All software paths end here with a clipped rect */
+static void software_fill(TGuiPainter *painter, TGuiRectangle rect, tgui_u32 color) {
+    if(tgui_rect_invalid(rect)) return;
+    software_add_damage(painter, rect);
+    if(painter->type == TGUI_PAINTER_TYPE_SOFTWARE_BINNED) {
+        tile_binner_push(painter, TGUI_SOFTWARE_COMMAND_FILL, rect, color, NULL, NULL, 0, 0);
+    } else {
+        raster_fill(painter->pixels, tgui_rect_width(painter->dim), rect, color);
+    }
+}
+
+static void software_copy_bitmap(TGuiPainter *painter, TGuiRectangle rect, TGuiBitmap *bitmap, tgui_s32 src_x, tgui_s32 src_y) {
+    if(tgui_rect_invalid(rect)) return;
+    software_add_damage(painter, rect);
+    if(painter->type == TGUI_PAINTER_TYPE_SOFTWARE_BINNED) {
+        tile_binner_push(painter, TGUI_SOFTWARE_COMMAND_COPY_BITMAP, rect, 0, bitmap, NULL, src_x, src_y);
+    } else {
+        raster_copy_bitmap(painter->pixels, tgui_rect_width(painter->dim), rect, bitmap, src_x, src_y);
+    }
+}
+
+static void software_blend_bitmap(TGuiPainter *painter, TGuiRectangle rect, TGuiBitmap *bitmap, tgui_s32 src_x, tgui_s32 src_y, tgui_u32 tint) {
+    if(tgui_rect_invalid(rect)) return;
+    software_add_damage(painter, rect);
+    if(painter->type == TGUI_PAINTER_TYPE_SOFTWARE_BINNED) {
+        tile_binner_push(painter, TGUI_SOFTWARE_COMMAND_BLEND_BITMAP, rect, tint, bitmap, NULL, src_x, src_y);
+    } else {
+        raster_blend_bitmap(painter->pixels, tgui_rect_width(painter->dim), rect, bitmap, src_x, src_y, tint);
+    }
+}
+
+static void software_blend_coverage(TGuiPainter *painter, TGuiRectangle rect, TGuiGlyphAtlas *glyph_atlas, tgui_s32 src_x, tgui_s32 src_y, tgui_u32 tint) {
+    if(tgui_rect_invalid(rect)) return;
+    software_add_damage(painter, rect);
+    if(painter->type == TGUI_PAINTER_TYPE_SOFTWARE_BINNED) {
+        tile_binner_push(painter, TGUI_SOFTWARE_COMMAND_BLEND_COVERAGE, rect, tint, NULL, glyph_atlas, src_x, src_y);
+    } else {
+        raster_blend_coverage(painter->pixels, tgui_rect_width(painter->dim), rect, glyph_atlas, src_x, src_y, tint);
+    }
+}
+
+static void software_blend_sdf(TGuiPainter *painter, TGuiRectangle rect, TGuiGlyphAtlas *glyph_atlas, TGuiRectangle src_rect, TGuiRectangle dst_rect, tgui_u32 tint) {
+    if(tgui_rect_invalid(rect)) return;
+    software_add_damage(painter, rect);
+    if(painter->type == TGUI_PAINTER_TYPE_SOFTWARE_BINNED) {
+        TGuiSoftwareCommand *command = tile_binner_push(painter, TGUI_SOFTWARE_COMMAND_BLEND_SDF, rect, tint, NULL, glyph_atlas, 0, 0);
+        command->src_rect = src_rect;
+        command->dst_rect = dst_rect;
+    } else {
+        raster_blend_sdf(painter->pixels, tgui_rect_width(painter->dim), rect, glyph_atlas, src_rect, dst_rect, tint);
+    }
 }
 
 void tgui_painter_draw_pixel(TGuiPainter *painter, tgui_s32 x, tgui_s32 y, tgui_u32 color) {
     if(x >= painter->clip.min_x && x <= painter->clip.max_x &&
        y >= painter->clip.min_y && y <= painter->clip.max_y) {
-        tgui_u32 painter_w = tgui_rect_width(painter->clip);
-        tgui_u32 *pixel = painter->pixels + (y * painter_w) + x;
-        *pixel = color;
+        TGuiRectangle pixel = { x, y, x, y };
+        software_fill(painter, pixel, color);
+    }
+}
+
+
+/* ----------------------- */
+/*       TGui Damage       */
+/* ----------------------- */
+
+static tgui_s64 damage_rect_area(TGuiRectangle rect) {
+    return (tgui_s64)tgui_rect_width(rect) * (tgui_s64)tgui_rect_height(rect);
+}
+
+static void damage_remove(TGuiDamage *damage, tgui_u32 index) {
+    TGUI_ASSERT(index < damage->rects_count);
+    damage->rects[index] = damage->rects[--damage->rects_count];
+}
+
+void tgui_damage_clear(TGuiDamage *damage) {
+    damage->rects_count = 0;
+}
+
+void tgui_damage_add(TGuiDamage *damage, TGuiRectangle rect) {
+    
+    if(tgui_rect_invalid(rect)) return;
+
+    for(tgui_u32 i = 0; i < damage->rects_count; ++i) {
+        if(tgui_rect_inside(rect, damage->rects[i])) return;
     }
+
+    for(tgui_u32 i = 0; i < damage->rects_count;) {
+        if(tgui_rect_inside(damage->rects[i], rect)) {
+            damage_remove(damage, i);
+        } else {
+            ++i;
+        }
+    }
+
+    if(damage->rects_count < TGUI_DAMAGE_MAX_RECTS) {
+        damage->rects[damage->rects_count++] = rect;
+        return;
+    }
+    
+    /* NOTE: Merge with the rectangle that adds less undamaged area, the union can contain other rectangles so it is added again */
+    tgui_u32 best_index = 0;
+    tgui_s64 best_waste = 0;
+    for(tgui_u32 i = 0; i < damage->rects_count; ++i) {
+        TGuiRectangle merged = tgui_rect_union(damage->rects[i], rect);
+        tgui_s64 waste = damage_rect_area(merged) - damage_rect_area(damage->rects[i]) - damage_rect_area(rect);
+        if(i == 0 || waste < best_waste) {
+            best_index = i;
+            best_waste = waste;
+        }
+    }
+
+    TGuiRectangle merged = tgui_rect_union(damage->rects[best_index], rect);
+    damage_remove(damage, best_index);
+    tgui_damage_add(damage, merged);
 }
 
+tgui_b32 tgui_damage_is_empty(TGuiDamage *damage) {
+    return damage->rects_count == 0;
+}
+
+tgui_b32 tgui_damage_overlaps(TGuiDamage *damage, TGuiRectangle rect) {
+    for(tgui_u32 i = 0; i < damage->rects_count; ++i) {
+        if(!tgui_rect_invalid(tgui_rect_intersection(damage->rects[i], rect))) return true;
+    }
+    return false;
+}
+
+TGuiRectangle tgui_damage_bounds(TGuiDamage *damage) {
+    TGuiRectangle result = tgui_rect_set_invalid();
+    for(tgui_u32 i = 0; i < damage->rects_count; ++i) {
+        result = (i == 0) ? damage->rects[i] : tgui_rect_union(result, damage->rects[i]);
+    }
+    return result;
+}
+
+void tgui_painter_set_damage(TGuiPainter *painter, TGuiDamage *damage) {
+    painter->damage = damage;
+}
 
 void tgui_painter_start(TGuiPainter *painter, TGuiPainterType type, TGuiRectangle dim, TGuiRectangle *clip, tgui_u32 *pixels, TGuiRenderBuffer *render_buffer) {
     painter->type = type;
@@ -60,68 +958,59 @@ void tgui_painter_start(TGuiPainter *painter, TGuiPainterType type, TGuiRectangl
         painter->clip = dim;
     }
     
-    if(painter->type == TGUI_PAINTER_TYPE_HARDWARE) {
+    painter->binner = NULL;
+    painter->damage = NULL;
+    
+    if(tgui_painter_is_hardware(painter)) {
         painter->render_buffer = render_buffer;
+    } else {
+        raster_kernels_select();
     }
 
 }
 
-void tgui_painter_draw_rectangle(TGuiPainter *painter, TGuiRectangle rectangle, tgui_u32 color) {
+
+void tgui_painter_start_binned(TGuiPainter *painter, TGuiRectangle dim, TGuiRectangle *clip, tgui_u32 *pixels, TGuiTileBinner *binner) {
+    
+    TGUI_ASSERT(dim.min_x == 0 && dim.min_y == 0);
     
-    clip_rectangle(&rectangle, painter->clip, 0, 0);
+    tgui_painter_start(painter, TGUI_PAINTER_TYPE_SOFTWARE_BINNED, dim, clip, pixels, NULL);
+    painter->binner = binner;
+
+    TGUI_ASSERT(tgui_array_size(&binner->commands) == 0);
+    binner->pixels = pixels;
+    binner->stride = tgui_rect_width(dim);
+    binner->width  = tgui_rect_width(dim);
+    binner->height = tgui_rect_height(dim);
+    binner->tiles_x = (binner->width  + TGUI_TILE_SIZE - 1) / TGUI_TILE_SIZE;
+    binner->tiles_y = (binner->height + TGUI_TILE_SIZE - 1) / TGUI_TILE_SIZE;
+}
+
+void tgui_painter_flush(TGuiPainter *painter) {
+    if(painter->type == TGUI_PAINTER_TYPE_SOFTWARE_BINNED) {
+        tile_binner_flush(painter->binner, painter->damage);
+    }
+}
 
+void tgui_painter_draw_rectangle(TGuiPainter *painter, TGuiRectangle rectangle, tgui_u32 color) {
+    
     switch (painter->type) {
-    case TGUI_PAINTER_TYPE_HARDWARE: {
+    case TGUI_PAINTER_TYPE_HARDWARE:
+    case TGUI_PAINTER_TYPE_HARDWARE_INSTANCED: {
         
-        if(tgui_rect_invalid(rectangle)) return;
-
-        TGuiVertexArray *vertex_buffer = &painter->render_buffer->vertex_buffer;
-        TGuiU32Array *index_buffer = &painter->render_buffer->index_buffer;
+        if(!hardware_clip_rectangle(painter, &rectangle, 0, 0)) return;
 
         rectangle.max_x += 1;
         rectangle.max_y += 1;
         
-        tgui_u32 start_vertex_index = tgui_array_size(vertex_buffer);
-
-        TGuiVertex *vertex0 = tgui_array_push(vertex_buffer);
-        TGuiVertex *vertex1 = tgui_array_push(vertex_buffer);
-        TGuiVertex *vertex2 = tgui_array_push(vertex_buffer);
-        TGuiVertex *vertex3 = tgui_array_push(vertex_buffer);
-        
-        setup_vertex(vertex0, rectangle.min_x, rectangle.min_y, 0.0f, 0.0f, color);
-        setup_vertex(vertex1, rectangle.min_x, rectangle.max_y, 0.0f, 0.0f, color);
-        setup_vertex(vertex2, rectangle.max_x, rectangle.max_y, 0.0f, 0.0f, color);
-        setup_vertex(vertex3, rectangle.max_x, rectangle.min_y, 0.0f, 0.0f, color);
-        
-        tgui_u32 *index0 = tgui_array_push(index_buffer);
-        tgui_u32 *index1 = tgui_array_push(index_buffer);
-        tgui_u32 *index2 = tgui_array_push(index_buffer);
-
-        *index0 = start_vertex_index + 0;
-        *index1 = start_vertex_index + 1;
-        *index2 = start_vertex_index + 2;
-
-        tgui_u32 *index3 = tgui_array_push(index_buffer);
-        tgui_u32 *index4 = tgui_array_push(index_buffer);
-        tgui_u32 *index5 = tgui_array_push(index_buffer);
-
-        *index3 = start_vertex_index + 2;
-        *index4 = start_vertex_index + 3;
-        *index5 = start_vertex_index + 0;
+        push_quad(painter, rectangle, 0.0f, 0.0f, 0.0f, 0.0f, 0, color, NULL, false);
     
     } break;
-    case TGUI_PAINTER_TYPE_SOFTWARE: {
+    case TGUI_PAINTER_TYPE_SOFTWARE:
+    case TGUI_PAINTER_TYPE_SOFTWARE_BINNED: {
 
-        tgui_u32 painter_w = tgui_rect_width(painter->dim);
-        tgui_u32 *row = painter->pixels + (rectangle.min_y * painter_w) + rectangle.min_x;
-
-        for(tgui_s32 y = rectangle.min_y; y <= rectangle.max_y; ++y) {
-            tgui_u32 *pixel = row;
-            for(tgui_s32 x = rectangle.min_x; x <= rectangle.max_x; ++x) {
-                *pixel++ = color;
-            }
-            row += painter_w;
-        }
+        clip_rectangle(&rectangle, painter->clip, 0, 0);
+        software_fill(painter, rectangle, color);
 
     }break;
     
@@ -142,7 +1031,8 @@ void tgui_painter_draw_rectangle_outline(TGuiPainter *painter, TGuiRectangle rec
 
     switch (painter->type) {
     
-    case TGUI_PAINTER_TYPE_HARDWARE: {
+    case TGUI_PAINTER_TYPE_HARDWARE:
+    case TGUI_PAINTER_TYPE_HARDWARE_INSTANCED: {
 
         TGuiRectangle l = rectangle;
         l.max_x = l.min_x;
@@ -159,7 +1049,8 @@ void tgui_painter_draw_rectangle_outline(TGuiPainter *painter, TGuiRectangle rec
         tgui_painter_draw_rectangle(painter, b, color);
 
     } break;
-    case TGUI_PAINTER_TYPE_SOFTWARE: {
+    case TGUI_PAINTER_TYPE_SOFTWARE:
+    case TGUI_PAINTER_TYPE_SOFTWARE_BINNED: {
 
         tgui_painter_draw_hline(painter, rectangle.min_y, rectangle.min_x, rectangle.max_x, color);
         tgui_painter_draw_hline(painter, rectangle.max_y, rectangle.min_x, rectangle.max_x, color);
@@ -176,10 +1067,12 @@ void tgui_painter_draw_bitmap_no_alpha(TGuiPainter *painter, tgui_s32 x, tgui_s3
 
     switch (painter->type) {
 
-    case TGUI_PAINTER_TYPE_HARDWARE: {
+    case TGUI_PAINTER_TYPE_HARDWARE:
+    case TGUI_PAINTER_TYPE_HARDWARE_INSTANCED: {
         tgui_painter_draw_bitmap(painter, x, y, bitmap, 0xffffff);
     } break;
-    case TGUI_PAINTER_TYPE_SOFTWARE: {
+    case TGUI_PAINTER_TYPE_SOFTWARE:
+    case TGUI_PAINTER_TYPE_SOFTWARE_BINNED: {
 
         TGuiRectangle rect;
         rect.min_x = x;
@@ -191,19 +1084,7 @@ void tgui_painter_draw_bitmap_no_alpha(TGuiPainter *painter, tgui_s32 x, tgui_s3
         tgui_s32 offset_y;
         clip_rectangle(&rect, painter->clip, &offset_x, &offset_y);
 
-        tgui_u32 painter_w = tgui_rect_width(painter->dim);
-        tgui_u32 *row = painter->pixels + (rect.min_y * painter_w) + rect.min_x;
-        tgui_u32 *src_row = bitmap->pixels + (offset_y * bitmap->width) + offset_x;
-
-        for(y = rect.min_y; y <= rect.max_y; ++y) {
-            tgui_u32 *pixel = row;
-            tgui_u32 *src_pixel = src_row;
-            for(x = rect.min_x; x <= rect.max_x; ++x) {
-                *pixel++ = *src_pixel++;
-            }
-            row += painter_w;
-            src_row += bitmap->width;
-        }
+        software_copy_bitmap(painter, rect, bitmap, offset_x, offset_y);
 
     } break;
 
@@ -222,18 +1103,20 @@ void tgui_painter_draw_bitmap(TGuiPainter *painter, tgui_s32 x, tgui_s32 y, TGui
     
     tgui_s32 offset_x;
     tgui_s32 offset_y;
-    clip_rectangle(&rectangle, painter->clip, &offset_x, &offset_y);
 
     switch (painter->type) {
 
-    case TGUI_PAINTER_TYPE_HARDWARE: {
+    case TGUI_PAINTER_TYPE_HARDWARE:
+    case TGUI_PAINTER_TYPE_HARDWARE_INSTANCED: {
         
-        if(tgui_rect_invalid(rectangle)) return;
-
-        TGuiVertexArray *vertex_buffer = &painter->render_buffer->vertex_buffer;
-        TGuiU32Array *index_buffer = &painter->render_buffer->index_buffer;
+        if(!hardware_clip_rectangle(painter, &rectangle, &offset_x, &offset_y)) return;
 
-        TGUI_ASSERT(bitmap->texture);
+        TGuiTextureAtlas *texture_atlas = painter->render_buffer->texture_atlas;
+        TGUI_ASSERT(texture_atlas && bitmap->texture != TGUI_TEXTURE_HANDLE_INVALID);
+        
+        /* NOTE: The bitmap was evicted or is waiting for space in the texture atlas */
+        TGuiTexture *texture = tgui_texture_atlas_use_texture(texture_atlas, bitmap->texture);
+        if(!texture) return;
 
         rectangle.max_x += 1;
         rectangle.max_y += 1;
@@ -241,97 +1124,187 @@ void tgui_painter_draw_bitmap(TGuiPainter *painter, tgui_s32 x, tgui_s32 y, TGui
         unclip_rectangle.max_x += 1;
         unclip_rectangle.max_y += 1;
 
-        tgui_u32 start_vertex_index = tgui_array_size(vertex_buffer);
+        tgui_f32 min_u = texture->min_u; 
+        tgui_f32 min_v = texture->min_v;
+        tgui_f32 max_u = texture->max_u; 
+        tgui_f32 max_v = texture->max_v;
+
+        /* NOTE: Only quads outside of the int16 range are clipped here */
+        if(!tgui_rect_equals(rectangle, unclip_rectangle)) {
+            
+            tgui_u32 max_offset_x = unclip_rectangle.max_x - rectangle.max_x;
+            tgui_u32 max_offset_y = unclip_rectangle.max_y - rectangle.max_y;
+            
+            tgui_f32 texel_u = 1.0f / (tgui_f32)TGUI_TEXTURE_ATLAS_PAGE_SIZE;
+            tgui_f32 texel_v = 1.0f / (tgui_f32)TGUI_TEXTURE_ATLAS_PAGE_SIZE;
+            
+            min_u += (tgui_f32)offset_x * texel_u;
+            min_v += (tgui_f32)offset_y * texel_v;
+            max_u -= (tgui_f32)max_offset_x * texel_u;
+            max_v -= (tgui_f32)max_offset_y * texel_v;
+        }
+
+        push_quad(painter, rectangle, min_u, min_v, max_u, max_v, texture->page, tint, painter->render_buffer->texture, false);
+    
+    } break;
+    case TGUI_PAINTER_TYPE_SOFTWARE:
+    case TGUI_PAINTER_TYPE_SOFTWARE_BINNED: {
 
-        TGuiVertex *vertex0 = tgui_array_push(vertex_buffer);
-        TGuiVertex *vertex1 = tgui_array_push(vertex_buffer);
-        TGuiVertex *vertex2 = tgui_array_push(vertex_buffer);
-        TGuiVertex *vertex3 = tgui_array_push(vertex_buffer);
-        
-        tgui_u32 color = tint;
+        clip_rectangle(&rectangle, painter->clip, &offset_x, &offset_y);
+        software_blend_bitmap(painter, rectangle, bitmap, offset_x, offset_y, tint);
+
+    } break;
+
+    }
+}
+
+/* NOTE: Rectangle (max exclusive) and texture coordinates of a glyph for the hardware painters,
+   returns false if the glyph is not drawn */
+static inline tgui_b32 hardware_glyph_quad(TGuiPainter *painter, tgui_s32 x, tgui_s32 y, TGuiGlyphAtlas *glyph_atlas, TGuiRectangle glyph_dim, TGuiRectangle *rectangle, tgui_f32 *uvs) {
+
+    /* NOTE: The glyph was added after the last upload of the atlas */
+    if(glyph_dim.max_x >= (tgui_s32)glyph_atlas->texture_width || glyph_dim.max_y >= (tgui_s32)glyph_atlas->texture_height) return false;
 
-        tgui_u32 min_offset_x = offset_x;
-        tgui_u32 min_offset_y = offset_y;
-        tgui_u32 max_offset_x = unclip_rectangle.max_x - rectangle.max_x;
-        tgui_u32 max_offset_y = unclip_rectangle.max_y - rectangle.max_y;
+    rectangle->min_x = x;
+    rectangle->min_y = y;
+    rectangle->max_x = x + (glyph_dim.max_x - glyph_dim.min_x);
+    rectangle->max_y = y + (glyph_dim.max_y - glyph_dim.min_y);
 
-        TGuiTexture *texture = bitmap->texture;
-        TGuiRectangle texture_rectangle = texture->dim;
-        texture_rectangle.max_x += 1;
-        texture_rectangle.max_y += 1;
+    TGuiRectangle unclip_rectangle = *rectangle;
+    
+    tgui_s32 offset_x;
+    tgui_s32 offset_y;
+    if(!hardware_clip_rectangle(painter, rectangle, &offset_x, &offset_y)) return false;
+
+    tgui_s32 max_offset_x = unclip_rectangle.max_x - rectangle->max_x;
+    tgui_s32 max_offset_y = unclip_rectangle.max_y - rectangle->max_y;
+    
+    rectangle->max_x += 1;
+    rectangle->max_y += 1;
+
+    uvs[0] = (tgui_f32)(glyph_dim.min_x + offset_x) * glyph_atlas->texel_u; 
+    uvs[1] = (tgui_f32)(glyph_dim.min_y + offset_y) * glyph_atlas->texel_v;
+    uvs[2] = (tgui_f32)(glyph_dim.max_x + 1 - max_offset_x) * glyph_atlas->texel_u; 
+    uvs[3] = (tgui_f32)(glyph_dim.max_y + 1 - max_offset_y) * glyph_atlas->texel_v;
+
+    return true;
+}
+
+void tgui_painter_draw_glyph(TGuiPainter *painter, tgui_s32 x, tgui_s32 y, TGuiGlyphAtlas *glyph_atlas, TGuiRectangle glyph_dim, tgui_u32 tint) {
+
+    if(tgui_rect_invalid(glyph_dim)) return;
+
+    switch (painter->type) {
+
+    case TGUI_PAINTER_TYPE_HARDWARE:
+    case TGUI_PAINTER_TYPE_HARDWARE_INSTANCED: {
         
-        TGuiTextureAtlas *texture_atlas = painter->render_buffer->texture_atlas;
-        TGUI_ASSERT(texture_atlas);
+        TGuiRectangle rectangle;
+        tgui_f32 uvs[4];
+        if(!hardware_glyph_quad(painter, x, y, glyph_atlas, glyph_dim, &rectangle, uvs)) return;
+        push_quad(painter, rectangle, uvs[0], uvs[1], uvs[2], uvs[3], 0, tint, glyph_atlas->texture, false);
+    
+    } break;
+    case TGUI_PAINTER_TYPE_SOFTWARE:
+    case TGUI_PAINTER_TYPE_SOFTWARE_BINNED: {
+
+        TGuiRectangle rectangle;
+        rectangle.min_x = x;
+        rectangle.min_y = y;
+        rectangle.max_x = x + tgui_rect_width(glyph_dim)  - 1;
+        rectangle.max_y = y + tgui_rect_height(glyph_dim) - 1;
+        
+        tgui_s32 offset_x;
+        tgui_s32 offset_y;
+        clip_rectangle(&rectangle, painter->clip, &offset_x, &offset_y);
+        software_blend_coverage(painter, rectangle, glyph_atlas, glyph_dim.min_x + offset_x, glyph_dim.min_y + offset_y, tint);
+
+    } break;
+
+    }
+}
 
-        tgui_u32 texture_atlas_w = texture_atlas->bitmap.width;
-        tgui_u32 texture_atlas_h = texture_atlas->bitmap.height;
+void tgui_painter_draw_glyph_run(TGuiPainter *painter, TGuiGlyphAtlas *glyph_atlas, TGuiGlyphRunItem *items, tgui_u32 items_count, tgui_u32 tint) {
 
-        tgui_f32 min_u = (tgui_f32)(texture_rectangle.min_x + min_offset_x) / (tgui_f32)texture_atlas_w; 
-        tgui_f32 min_v = (tgui_f32)(texture_rectangle.min_y + min_offset_y) / (tgui_f32)texture_atlas_h;
-        tgui_f32 max_u = (tgui_f32)(texture_rectangle.max_x - max_offset_x) / (tgui_f32)texture_atlas_w; 
-        tgui_f32 max_v = (tgui_f32)(texture_rectangle.max_y - max_offset_y) / (tgui_f32)texture_atlas_h;
+    if(!tgui_painter_is_hardware(painter)) {
+        for(tgui_u32 i = 0; i < items_count; ++i) {
+            tgui_painter_draw_glyph(painter, items[i].x, items[i].y, glyph_atlas, items[i].dim, tint);
+        }
+        return;
+    }
 
-        setup_vertex(vertex0, rectangle.min_x, rectangle.min_y, min_u, min_v, color);
-        setup_vertex(vertex1, rectangle.min_x, rectangle.max_y, min_u, max_v, color);
-        setup_vertex(vertex2, rectangle.max_x, rectangle.max_y, max_u, max_v, color);
-        setup_vertex(vertex3, rectangle.max_x, rectangle.min_y, max_u, min_v, color);
+    /* NOTE: All the quads of the run share the clip and the texture, they are added to the
+       draw commands at once after they are pushed */
+    TGuiRenderBuffer *render_buffer = painter->render_buffer;
+    tgui_b32 instanced = (painter->type == TGUI_PAINTER_TYPE_HARDWARE_INSTANCED);
+    tgui_u32 quads_count = 0;
+
+    for(tgui_u32 i = 0; i < items_count; ++i) {
+        
+        TGuiGlyphRunItem *item = items + i;
+        if(tgui_rect_invalid(item->dim)) continue;
+        
+        TGuiRectangle rectangle;
+        tgui_f32 uvs[4];
+        if(!hardware_glyph_quad(painter, item->x, item->y, glyph_atlas, item->dim, &rectangle, uvs)) continue;
         
-        tgui_u32 *index0 = tgui_array_push(index_buffer);
-        tgui_u32 *index1 = tgui_array_push(index_buffer);
-        tgui_u32 *index2 = tgui_array_push(index_buffer);
+        if(instanced) {
+            push_quad_instance(render_buffer, rectangle, uvs[0], uvs[1], uvs[2], uvs[3], tint, 0);
+        } else {
+            push_quad_vertices(render_buffer, rectangle, uvs[0], uvs[1], uvs[2], uvs[3], tint, 0);
+        }
+        ++quads_count;
+    }
 
-        *index0 = start_vertex_index + 0;
-        *index1 = start_vertex_index + 1;
-        *index2 = start_vertex_index + 2;
+    if(quads_count > 0) {
+        tgui_render_buffer_add_quads(render_buffer, painter->clip, glyph_atlas->texture, false, quads_count);
+    }
+}
 
-        tgui_u32 *index3 = tgui_array_push(index_buffer);
-        tgui_u32 *index4 = tgui_array_push(index_buffer);
-        tgui_u32 *index5 = tgui_array_push(index_buffer);
+void tgui_painter_draw_glyph_sdf(TGuiPainter *painter, TGuiRectangle rectangle, TGuiGlyphAtlas *glyph_atlas, TGuiRectangle glyph_dim, tgui_u32 tint) {
 
-        *index3 = start_vertex_index + 2;
-        *index4 = start_vertex_index + 3;
-        *index5 = start_vertex_index + 0;
+    if(tgui_rect_invalid(glyph_dim) || tgui_rect_invalid(rectangle)) return;
+
+    TGuiRectangle unclip_rectangle = rectangle;
+    
+    tgui_s32 offset_x;
+    tgui_s32 offset_y;
+
+    switch (painter->type) {
+
+    case TGUI_PAINTER_TYPE_HARDWARE:
+    case TGUI_PAINTER_TYPE_HARDWARE_INSTANCED: {
+        
+        /* NOTE: The glyph was added after the last upload of the atlas */
+        if(glyph_dim.max_x >= (tgui_s32)glyph_atlas->texture_width || glyph_dim.max_y >= (tgui_s32)glyph_atlas->texture_height) return;
         
+        if(!hardware_clip_rectangle(painter, &rectangle, &offset_x, &offset_y)) return;
+
+        rectangle.max_x += 1;
+        rectangle.max_y += 1;
+
+        unclip_rectangle.max_x += 1;
+        unclip_rectangle.max_y += 1;
+
+        tgui_f32 scale_x = (tgui_f32)tgui_rect_width(glyph_dim) / (tgui_f32)tgui_rect_width(unclip_rectangle);
+        tgui_f32 scale_y = (tgui_f32)tgui_rect_height(glyph_dim) / (tgui_f32)tgui_rect_height(unclip_rectangle);
+
+        tgui_f32 max_offset_x = (tgui_f32)(unclip_rectangle.max_x - rectangle.max_x) * scale_x;
+        tgui_f32 max_offset_y = (tgui_f32)(unclip_rectangle.max_y - rectangle.max_y) * scale_y;
+
+        tgui_f32 min_u = ((tgui_f32)glyph_dim.min_x + (tgui_f32)offset_x * scale_x) * glyph_atlas->texel_u; 
+        tgui_f32 min_v = ((tgui_f32)glyph_dim.min_y + (tgui_f32)offset_y * scale_y) * glyph_atlas->texel_v;
+        tgui_f32 max_u = ((tgui_f32)glyph_dim.max_x + 1.0f - max_offset_x) * glyph_atlas->texel_u; 
+        tgui_f32 max_v = ((tgui_f32)glyph_dim.max_y + 1.0f - max_offset_y) * glyph_atlas->texel_v;
+
+        push_quad(painter, rectangle, min_u, min_v, max_u, max_v, 0, tint, glyph_atlas->texture, true);
     
     } break;
-    case TGUI_PAINTER_TYPE_SOFTWARE: {
-
-        tgui_u32 painter_w = tgui_rect_width(painter->dim);
-        tgui_u32 *row = painter->pixels + (rectangle.min_y * painter_w) + rectangle.min_x;
-        tgui_u32 *src_row = bitmap->pixels + (offset_y * bitmap->width) + offset_x;
-
-        for(y = rectangle.min_y; y <= rectangle.max_y; ++y) {
-            tgui_u32 *pixel = row;
-            tgui_u32 *src_pixel = src_row;
-            for(x = rectangle.min_x; x <= rectangle.max_x; ++x) {
-
-                tgui_u32 src = *src_pixel;
-                tgui_u32 des = *pixel;
-                
-                tgui_f32 tr = ((tint >> 16) & 0xff) / 255.0f;
-                tgui_f32 tg = ((tint >>  8) & 0xff) / 255.0f;
-                tgui_f32 tb = ((tint >>  0) & 0xff) / 255.0f;
-
-                tgui_u32 sr = ((src >> 16) & 0xff) * tr;
-                tgui_u32 sg = ((src >>  8) & 0xff) * tg;
-                tgui_u32 sb = ((src >>  0) & 0xff) * tb;
-
-                tgui_u32 dr = (des >> 16) & 0xff;
-                tgui_u32 dg = (des >>  8) & 0xff;
-                tgui_u32 db = (des >>  0) & 0xff;
-
-                tgui_f32 sa = ((src >> 24) & 0xff) / 255.0f;
-                
-                tgui_u32 cr = (dr * (1.0f - sa) + sr * sa);
-                tgui_u32 cg = (dg * (1.0f - sa) + sg * sa);
-                tgui_u32 cb = (db * (1.0f - sa) + sb * sa);
-
-                *pixel++ = (cr << 16) | (cg << 8) | (cb << 0);
-                src_pixel++;
-            }
-            row += painter_w;
-            src_row += bitmap->width;
-        }
+    case TGUI_PAINTER_TYPE_SOFTWARE:
+    case TGUI_PAINTER_TYPE_SOFTWARE_BINNED: {
+
+        clip_rectangle(&rectangle, painter->clip, &offset_x, &offset_y);
+        software_blend_sdf(painter, rectangle, glyph_atlas, glyph_dim, unclip_rectangle, tint);
 
     } break;
 
@@ -341,7 +1314,8 @@ void tgui_painter_draw_bitmap(TGuiPainter *painter, tgui_s32 x, tgui_s32 y, TGui
 void tgui_painter_draw_vline(TGuiPainter *painter, tgui_s32 x, tgui_s32 y0, tgui_s32 y1, tgui_u32 color) {
 
     switch (painter->type) {
-    case TGUI_PAINTER_TYPE_HARDWARE: {
+    case TGUI_PAINTER_TYPE_HARDWARE:
+    case TGUI_PAINTER_TYPE_HARDWARE_INSTANCED: {
 
         TGuiRectangle vline;
         vline.min_x = x;
@@ -351,7 +1325,8 @@ void tgui_painter_draw_vline(TGuiPainter *painter, tgui_s32 x, tgui_s32 y0, tgui
         tgui_painter_draw_rectangle(painter, vline, color);
 
     } break;
-    case TGUI_PAINTER_TYPE_SOFTWARE: {
+    case TGUI_PAINTER_TYPE_SOFTWARE:
+    case TGUI_PAINTER_TYPE_SOFTWARE_BINNED: {
 
         if(x < painter->clip.min_x)  return;
         if(x > painter->clip.max_x) return; 
@@ -359,13 +1334,8 @@ void tgui_painter_draw_vline(TGuiPainter *painter, tgui_s32 x, tgui_s32 y0, tgui
         if(y0 < painter->clip.min_y)  y0 = painter->clip.min_y; 
         if(y1 > painter->clip.max_y)  y1 = painter->clip.max_y; 
         
-        tgui_u32 painter_w = tgui_rect_width(painter->dim);
-        tgui_u32 *pixel = painter->pixels + (y0 * painter_w) + x;
-        
-        for(tgui_s32 y = y0; y <= y1; ++y) {
-            *pixel = color;
-            pixel += painter_w;
-        }
+        TGuiRectangle vline = { x, y0, x, y1 };
+        software_fill(painter, vline, color);
 
     } break;
     }
@@ -376,7 +1346,8 @@ void tgui_painter_draw_vline(TGuiPainter *painter, tgui_s32 x, tgui_s32 y0, tgui
 void tgui_painter_draw_hline(TGuiPainter *painter, tgui_s32 y, tgui_s32 x0, tgui_s32 x1, tgui_u32 color) {
 
     switch (painter->type) {
-    case TGUI_PAINTER_TYPE_HARDWARE: {
+    case TGUI_PAINTER_TYPE_HARDWARE:
+    case TGUI_PAINTER_TYPE_HARDWARE_INSTANCED: {
 
         TGuiRectangle hline;
         hline.min_y = y;
@@ -386,7 +1357,8 @@ void tgui_painter_draw_hline(TGuiPainter *painter, tgui_s32 y, tgui_s32 x0, tgui
         tgui_painter_draw_rectangle(painter, hline, color);
 
     } break;
-    case TGUI_PAINTER_TYPE_SOFTWARE: {
+    case TGUI_PAINTER_TYPE_SOFTWARE:
+    case TGUI_PAINTER_TYPE_SOFTWARE_BINNED: {
 
         if(y < painter->clip.min_y)  return; 
         if(y > painter->clip.max_y)  return; 
@@ -394,12 +1366,8 @@ void tgui_painter_draw_hline(TGuiPainter *painter, tgui_s32 y, tgui_s32 x0, tgui
         if(x0 < painter->clip.min_x) x0 = painter->clip.min_x; 
         if(x1 > painter->clip.max_x) x1 = painter->clip.max_x; 
         
-        tgui_u32 painter_w = tgui_rect_width(painter->dim);
-        tgui_u32 *pixel = painter->pixels + (y * painter_w) + x0;
-        
-        for(tgui_s32 x = x0; x <= x1; ++x) {
-            *pixel++ = color;
-        }
+        TGuiRectangle hline = { x0, y, x1, y };
+        software_fill(painter, hline, color);
 
     } break;
     }
@@ -411,58 +1379,26 @@ void tgui_painter_draw_render_buffer_texture(TGuiPainter *painter, TGuiRectangle
 
     TGuiRectangle rectangle = dim;
 
-    clip_rectangle(&rectangle, painter->clip, 0, 0);
-
     switch (painter->type) {
 
-    case TGUI_PAINTER_TYPE_HARDWARE: {
+    case TGUI_PAINTER_TYPE_HARDWARE:
+    case TGUI_PAINTER_TYPE_HARDWARE_INSTANCED: {
         
-        if(tgui_rect_invalid(rectangle)) return;
-
-        TGuiVertexArray *vertex_buffer = &painter->render_buffer->vertex_buffer;
-        TGuiU32Array *index_buffer = &painter->render_buffer->index_buffer;
+        if(!hardware_clip_rectangle(painter, &rectangle, 0, 0)) return;
 
         rectangle.max_x += 1;
         rectangle.max_y += 1;
 
-        tgui_u32 start_vertex_index = tgui_array_size(vertex_buffer);
-
-        TGuiVertex *vertex0 = tgui_array_push(vertex_buffer);
-        TGuiVertex *vertex1 = tgui_array_push(vertex_buffer);
-        TGuiVertex *vertex2 = tgui_array_push(vertex_buffer);
-        TGuiVertex *vertex3 = tgui_array_push(vertex_buffer);
-        
-        tgui_u32 color = 0xffffff;
-
         tgui_f32 min_u = 0.0f; 
         tgui_f32 min_v = 1.0f;
         tgui_f32 max_u = 1.0f; 
         tgui_f32 max_v = 0.0f;
 
-        setup_vertex(vertex0, rectangle.min_x, rectangle.min_y, min_u, min_v, color);
-        setup_vertex(vertex1, rectangle.min_x, rectangle.max_y, min_u, max_v, color);
-        setup_vertex(vertex2, rectangle.max_x, rectangle.max_y, max_u, max_v, color);
-        setup_vertex(vertex3, rectangle.max_x, rectangle.min_y, max_u, min_v, color);
-        
-        tgui_u32 *index0 = tgui_array_push(index_buffer);
-        tgui_u32 *index1 = tgui_array_push(index_buffer);
-        tgui_u32 *index2 = tgui_array_push(index_buffer);
-
-        *index0 = start_vertex_index + 0;
-        *index1 = start_vertex_index + 1;
-        *index2 = start_vertex_index + 2;
-
-        tgui_u32 *index3 = tgui_array_push(index_buffer);
-        tgui_u32 *index4 = tgui_array_push(index_buffer);
-        tgui_u32 *index5 = tgui_array_push(index_buffer);
-
-        *index3 = start_vertex_index + 2;
-        *index4 = start_vertex_index + 3;
-        *index5 = start_vertex_index + 0;
-        
+        push_quad(painter, rectangle, min_u, min_v, max_u, max_v, 0, 0xffffff, painter->render_buffer->texture, false);
     
     } break;
-    case TGUI_PAINTER_TYPE_SOFTWARE: {
+    case TGUI_PAINTER_TYPE_SOFTWARE:
+    case TGUI_PAINTER_TYPE_SOFTWARE_BINNED: {
         TGUI_ASSERT(!"Invalid code path");
     } break;
 
@@ -2,12 +2,109 @@
 #define _TGUI_PAINTER_H_
 
 #include "tgui_geometry.h"
+#include "tgui_gfx.h"
 
 typedef enum TGuiPainterType {
     TGUI_PAINTER_TYPE_SOFTWARE,
     TGUI_PAINTER_TYPE_HARDWARE,
+    TGUI_PAINTER_TYPE_HARDWARE_INSTANCED,
+    TGUI_PAINTER_TYPE_SOFTWARE_BINNED,
 } TGuiPainterType;
 
+/* ---------------------------- */
+/*       TGui Tile Binner       */
+/* ---------------------------- */
+
+/* NOTE: The binned software painter records the primitives already clipped, on flush they
+   are sorted in TGUI_TILE_SIZE tiles and the tiles are rasterized in parallel in the os
+   worker pool. Bitmaps drawn must be alive until the flush.
+
+   With damage the binner keeps a hash of the commands of every tile and only the tiles that
+   changed since the last flush are rasterized, the pixels of the rest are kept from the last
+   frame. Every frame has to draw the whole surface, a tile left without commands keeps its old
+   pixels. The content of the bitmaps is not hashed, invalidate the binner when it changes */
+
+#define TGUI_TILE_SIZE 64
+
+typedef enum TGuiSoftwareCommandType {
+    TGUI_SOFTWARE_COMMAND_FILL,
+    TGUI_SOFTWARE_COMMAND_COPY_BITMAP,
+    TGUI_SOFTWARE_COMMAND_BLEND_BITMAP,
+    TGUI_SOFTWARE_COMMAND_BLEND_COVERAGE,
+    TGUI_SOFTWARE_COMMAND_BLEND_SDF,
+} TGuiSoftwareCommandType;
+
+typedef struct TGuiSoftwareCommand {
+    TGuiSoftwareCommandType type;
+    TGuiRectangle rect;
+    tgui_u32 color;
+    TGuiBitmap *bitmap;
+    TGuiGlyphAtlas *glyph_atlas;
+    tgui_s32 src_x, src_y;
+    /* NOTE: Signed distance fields are scaled from src_rect to the unclipped dst_rect */
+    TGuiRectangle src_rect;
+    TGuiRectangle dst_rect;
+} TGuiSoftwareCommand;
+
+TGuiArray(TGuiSoftwareCommand, TGuiSoftwareCommandArray);
+
+typedef struct TGuiTileBinner {
+    
+    TGuiSoftwareCommandArray commands;
+    
+    /* NOTE: Commands of the tile i are tile_commands[tile_first_command[i]..tile_first_command[i+1]] */
+    TGuiU32Array tile_first_command;
+    TGuiU32Array tile_commands;
+
+    tgui_u32 *pixels;
+    tgui_u32 stride;
+    tgui_u32 width, height;
+    tgui_u32 tiles_x, tiles_y;
+
+    /* NOTE: Hash of the commands of every tile in the last flush with damage */
+    TGuiU64Array tile_hashes;
+    TGuiU32Array damaged_tiles;
+    tgui_u32 hashed_width, hashed_height;
+    tgui_b32 invalid;
+
+} TGuiTileBinner;
+
+void tgui_tile_binner_initialize(TGuiTileBinner *binner);
+
+void tgui_tile_binner_terminate(TGuiTileBinner *binner);
+
+/* NOTE: Rasterize every tile in the next flush */
+void tgui_tile_binner_invalidate(TGuiTileBinner *binner);
+
+/* ----------------------- */
+/*       TGui Damage       */
+/* ----------------------- */
+
+/* NOTE: Region written by the software painters, kept as up to TGUI_DAMAGE_MAX_RECTS rectangles.
+   When it is full the new rectangle is merged with the one that wastes less area. The host clears
+   it every frame, presents only the damaged rows and can skip the windows that do not overlap it */
+
+#define TGUI_DAMAGE_MAX_RECTS 16
+
+typedef struct TGuiDamage {
+    TGuiRectangle rects[TGUI_DAMAGE_MAX_RECTS];
+    tgui_u32 rects_count;
+} TGuiDamage;
+
+void tgui_damage_clear(TGuiDamage *damage);
+
+void tgui_damage_add(TGuiDamage *damage, TGuiRectangle rect);
+
+tgui_b32 tgui_damage_is_empty(TGuiDamage *damage);
+
+tgui_b32 tgui_damage_overlaps(TGuiDamage *damage, TGuiRectangle rect);
+
+TGuiRectangle tgui_damage_bounds(TGuiDamage *damage);
+
+/* ----------------------- */
+/*       TGui Painter      */
+/* ----------------------- */
+
 typedef struct TGuiPainter {
 
     TGuiPainterType type;
@@ -18,13 +115,25 @@ typedef struct TGuiPainter {
     tgui_u32 *pixels;
 
     struct TGuiRenderBuffer *render_buffer;
+    TGuiTileBinner *binner;
+    TGuiDamage *damage;
 
 } TGuiPainter;
 
-struct TGuiBitmap;
+#define tgui_painter_is_hardware(painter) \
+    ((painter)->type == TGUI_PAINTER_TYPE_HARDWARE || (painter)->type == TGUI_PAINTER_TYPE_HARDWARE_INSTANCED)
 
 void tgui_painter_start(TGuiPainter *painter, TGuiPainterType type, TGuiRectangle dim, TGuiRectangle *clip, tgui_u32 *pixels, struct TGuiRenderBuffer *render_buffer);
 
+void tgui_painter_start_binned(TGuiPainter *painter, TGuiRectangle dim, TGuiRectangle *clip, tgui_u32 *pixels, TGuiTileBinner *binner);
+
+/* NOTE: Every pixel written by a software painter after this call is added to damage, NULL stops the
+   tracking. A binned painter adds the tiles that changed since the last flush of its binner */
+void tgui_painter_set_damage(TGuiPainter *painter, TGuiDamage *damage);
+
+/* NOTE: Rasterize everything recorded by a binned painter, does nothing for the other types */
+void tgui_painter_flush(TGuiPainter *painter);
+
 void tgui_painter_clear(TGuiPainter *painter, tgui_u32 color);
 
 void tgui_painter_draw_rect(TGuiPainter *painter, tgui_s32 x, tgui_s32 y, tgui_s32 w, tgui_s32 h, tgui_u32 color);
@@ -37,9 +146,27 @@ void tgui_painter_draw_vline(TGuiPainter *painter, tgui_s32 x, tgui_s32 y0, tgui
 
 void tgui_painter_draw_hline(TGuiPainter *painter, tgui_s32 y, tgui_s32 x0, tgui_s32 x1, tgui_u32 color);
 
-void tgui_painter_draw_bitmap(TGuiPainter *painter, tgui_s32 x, tgui_s32 y, struct TGuiBitmap *bitmap, tgui_u32 tint);
+void tgui_painter_draw_bitmap(TGuiPainter *painter, tgui_s32 x, tgui_s32 y, TGuiBitmap *bitmap, tgui_u32 tint);
+
+/* NOTE: Draw the coverage stored in glyph_dim of the glyph atlas with the tint color */
+void tgui_painter_draw_glyph(TGuiPainter *painter, tgui_s32 x, tgui_s32 y, TGuiGlyphAtlas *glyph_atlas, TGuiRectangle glyph_dim, tgui_u32 tint);
+
+/* NOTE: Glyph of a run, the coverage in dim of the glyph atlas is drawn at (x, y) */
+typedef struct TGuiGlyphRunItem {
+    tgui_s32 x, y;
+    TGuiRectangle dim;
+} TGuiGlyphRunItem;
+
+TGuiArray(TGuiGlyphRunItem, TGuiGlyphRunItemArray);
+
+/* NOTE: Draw all the glyphs of a string with the tint color, the hardware painters push the quads
+   in one loop and add them to the draw commands at once */
+void tgui_painter_draw_glyph_run(TGuiPainter *painter, TGuiGlyphAtlas *glyph_atlas, TGuiGlyphRunItem *items, tgui_u32 items_count, tgui_u32 tint);
+
+/* NOTE: Draw the signed distance field stored in glyph_dim of the glyph atlas scaled to rectangle */
+void tgui_painter_draw_glyph_sdf(TGuiPainter *painter, TGuiRectangle rectangle, TGuiGlyphAtlas *glyph_atlas, TGuiRectangle glyph_dim, tgui_u32 tint);
 
-void tgui_painter_draw_bitmap_no_alpha(TGuiPainter *painter, tgui_s32 x, tgui_s32 y, struct TGuiBitmap *bitmap);
+void tgui_painter_draw_bitmap_no_alpha(TGuiPainter *painter, tgui_s32 x, tgui_s32 y, TGuiBitmap *bitmap);
 
 void tgui_painter_draw_render_buffer_texture(TGuiPainter *painter, TGuiRectangle dim);
 
@@ -3,15 +3,16 @@
 in vec2 vert;
 in vec2 uvs;
 in vec3 color;
+flat in float page;
 
 out vec4 fragment;
 
 uniform int res_x;
 uniform int res_y;
-uniform sampler2D tex;
+uniform sampler2DArray tex;
 
 void main() {
     
-    fragment = texture(tex, uvs) * vec4(color, 1.0);
+    fragment = texture(tex, vec3(uvs, page)) * vec4(color, 1.0);
 }
 
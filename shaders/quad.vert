@@ -3,6 +3,7 @@
 layout (location = 0) in vec2 aVert;
 layout (location = 1) in vec2 aUvs;
 layout (location = 2) in vec3 aColor;
+layout (location = 3) in float aPage;
 
 uniform int res_x;
 uniform int res_y;
@@ -10,6 +11,7 @@ uniform int res_y;
 out vec2 vert;
 out vec2 uvs;
 out vec3 color;
+flat out float page;
 
 void main() {
    
@@ -19,6 +21,7 @@ void main() {
 
     uvs   = aUvs;
     color = aColor;
+    page  = aPage;
 
     gl_Position = vec4(vert, 0, 1);
 }
@@ -0,0 +1,31 @@
+#version 330
+
+layout (location = 0) in vec4 aRect;
+layout (location = 1) in vec4 aUvRect;
+layout (location = 2) in vec4 aColor;
+layout (location = 3) in float aPage;
+
+uniform int res_x;
+uniform int res_y;
+
+out vec2 vert;
+out vec2 uvs;
+out vec3 color;
+flat out float page;
+
+void main() {
+    
+    // NOTE: The quad is drawn as a 4 vertices triangle strip
+    vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+
+    vec2 screen = vec2(res_x, res_y);
+    vec2 position = mix(aRect.xy, aRect.zw, corner);
+    vert.x = (position.x / screen.x) *  2 - 1;
+    vert.y = (position.y / screen.y) * -2 + 1;
+
+    uvs   = mix(aUvRect.xy, aUvRect.zw, corner);
+    color = aColor.rgb;
+    page  = aPage;
+
+    gl_Position = vec4(vert, 0, 1);
+}
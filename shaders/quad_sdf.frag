@@ -0,0 +1,45 @@
+#version 330
+
+in vec2 vert;
+in vec2 uvs;
+in vec3 color;
+flat in float page;
+
+out vec4 fragment;
+
+uniform int res_x;
+uniform int res_y;
+uniform sampler2DArray tex;
+
+// NOTE: The texture is a signed distance field, 0.5 is the outline of the glyph. The textures
+// are created with nearest filter so the bilinear filter is done here, the texels are clamped
+// to the texture so the full texel at (0, 0) can be used for solid quads
+float sample_distance(vec2 uv) {
+
+    ivec2 size = textureSize(tex, 0).xy;
+    int layer = int(page);
+    vec2 position = uv * vec2(size) - 0.5;
+
+    ivec2 texel = ivec2(floor(position));
+    ivec2 texel0 = clamp(texel, ivec2(0), size - 1);
+    ivec2 texel1 = clamp(texel + 1, ivec2(0), size - 1);
+    vec2 t = position - floor(position);
+
+    float d00 = texelFetch(tex, ivec3(texel0.x, texel0.y, layer), 0).a;
+    float d10 = texelFetch(tex, ivec3(texel1.x, texel0.y, layer), 0).a;
+    float d01 = texelFetch(tex, ivec3(texel0.x, texel1.y, layer), 0).a;
+    float d11 = texelFetch(tex, ivec3(texel1.x, texel1.y, layer), 0).a;
+
+    return mix(mix(d00, d10, t.x), mix(d01, d11, t.x), t.y);
+}
+
+void main() {
+
+    float distance = sample_distance(uvs);
+
+    // NOTE: Smooth the edge over one pixel of the screen
+    float width = max(fwidth(distance) * 0.5, 0.0001);
+    float alpha = smoothstep(0.5 - width, 0.5 + width, distance);
+
+    fragment = vec4(color, alpha);
+}